@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+# Counts the cache misses of the Shooter.Perf.CharacterTick automation test (200 characters) with perf stat on Linux.
+# The test runs twice, once only spawning and once ticking, and the difference between the two is the ticks alone.
+# For before/after figures, build each revision and run this against its editor.
+#
+# usage: Scripts/perf_character_tick.sh <path to UE4Editor-Cmd> [frames, default 600]
+set -euo pipefail
+
+EDITOR="${1:?usage: $0 <path to UE4Editor-Cmd> [frames]}"
+FRAMES="${2:-600}"
+PROJECT="$(cd "$(dirname "$0")/.." && pwd)/Shooter.uproject"
+EVENTS="cache-misses,cache-references,instructions,cycles"
+OUT="$(mktemp -d)"
+
+run_test() {
+	local frames="$1" name="$2"
+	perf stat -x, -e "$EVENTS" -o "$OUT/$name.perf" -- \
+		"$EDITOR" "$PROJECT" -nullrhi -nosound -nosplash -unattended -log \
+		-ShooterTickFrames="$frames" \
+		-ExecCmds="Automation RunTests Shooter.Perf.CharacterTick" \
+		-TestExit="Automation Test Queue Empty" > "$OUT/$name.log" 2>&1
+}
+
+run_test 0 spawn
+run_test "$FRAMES" tick
+
+grep -h "Character tick benchmark" "$OUT/tick.log" || echo "no benchmark line in $OUT/tick.log"
+
+# perf's csv lines are value,unit,event,...
+awk -F, -v frames="$FRAMES" '
+	FNR == 1 { file++ }
+	$3 != "" && $1 ~ /^[0-9]+$/ { count[file, $3] = $1; events[$3] = 1 }
+	END {
+		printf "%-18s %16s %16s %16s %14s\n", "event", "spawn only", "spawn + ticks", "ticks", "per tick"
+		for (event in events) {
+			delta = count[2, event] - count[1, event]
+			printf "%-18s %16d %16d %16d %14.1f\n", event, count[1, event], count[2, event], delta, delta / (frames * 200)
+		}
+	}' "$OUT/spawn.perf" "$OUT/tick.perf"
+
+echo "logs and raw counts in $OUT"
@@ -5,6 +5,7 @@ enum class EAmmoType : uint8
 {
 	EAT_9mm UMETA(DisplayName = "9mm"),
 	EAT_AR UMETA(DisplayName = "AssaultRifle"),
+	EAT_Shells UMETA(DisplayName = "Shells"),
 
 	EAT_MAX UMETA(DisplayName = "DefaultMax")
 };
\ No newline at end of file
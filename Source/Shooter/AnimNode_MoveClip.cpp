@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AnimNode_MoveClip.h"
+#include "Animation/AnimInstanceProxy.h"
+
+FAnimNode_MoveClip::FAnimNode_MoveClip() :
+	HandTransform(FTransform::Identity),
+	bMovingClip(false)
+{
+}
+
+void FAnimNode_MoveClip::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms)
+{
+	const FBoneContainer& BoneContainer = Output.Pose.GetPose().GetBoneContainer();
+	const FCompactPoseBoneIndex ClipBoneIndex = ClipBone.GetCompactPoseIndex(BoneContainer);
+
+	// hand transform is in world space, bring it into component space
+	FTransform ClipComponentTransform = HandTransform.GetRelativeTransform(Output.AnimInstanceProxy->GetComponentTransform());
+
+	// keep the scale of the clip bone from the incoming pose
+	ClipComponentTransform.SetScale3D(Output.Pose.GetComponentSpaceTransform(ClipBoneIndex).GetScale3D());
+
+	OutBoneTransforms.Add(FBoneTransform(ClipBoneIndex, ClipComponentTransform));
+}
+
+bool FAnimNode_MoveClip::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
+{
+	return bMovingClip && ClipBone.IsValidToEvaluate(RequiredBones);
+}
+
+void FAnimNode_MoveClip::InitializeBoneReferences(const FBoneContainer& RequiredBones)
+{
+	ClipBone.Initialize(RequiredBones);
+}
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "AnimNode_MoveClip.generated.h"
+
+/**
+ * Moves the clip bone of a weapon to the hand holding it while reloading.
+ * Evaluated on the anim worker thread from a transform copied once per update.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct SHOOTER_API FAnimNode_MoveClip : public FAnimNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+	// the clip bone on the weapon skeleton
+	UPROPERTY(EditAnywhere, Category = SkeletalControl)
+	FBoneReference ClipBone;
+
+	// world transform of the scene component attached to the characters hand
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SkeletalControl, meta = (PinShownByDefault))
+	FTransform HandTransform;
+
+	// true while the clip should follow the hand
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SkeletalControl, meta = (PinShownByDefault))
+	bool bMovingClip;
+
+	FAnimNode_MoveClip();
+
+	// FAnimNode_SkeletalControlBase interface
+	virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms) override;
+	virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+
+private:
+	// resolves ClipBone against the required bones once, instead of by name every reload
+	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
+};
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CombatRules.h"
+#include "ShooterTuningSettings.h"
+
+int32 FCombatRules::GetReloadAmount(int32 MagazineAmmo, int32 MagazineCapacity, int32 CarriedAmmo)
+{
+	const int32 MagEmptySpace{ FMath::Max(MagazineCapacity - MagazineAmmo, 0) };
+	return FMath::Clamp(CarriedAmmo, 0, MagEmptySpace);
+}
+
+int32 FCombatRules::GetCarriedAmmo(const TMap<EAmmoType, int32>& AmmoMap, EAmmoType AmmoType)
+{
+	const int32* CarriedAmmo = AmmoMap.Find(AmmoType);
+	return CarriedAmmo ? *CarriedAmmo : 0;
+}
+
+void FCrosshairSpread::Update(const FShooterTuning& Tuning, float DeltaTime, float GroundSpeed, bool bInAir, bool bAiming, bool bFiringBullet)
+{
+	VelocityFactor = FMath::GetMappedRangeValueClamped(FVector2D(0.f, Tuning.SpreadWalkSpeed), FVector2D(0.f, 1.f), GroundSpeed);
+
+	// spreads out slowly in the air and shrinks rapidly on landing
+	InAirFactor = bInAir ? FMath::FInterpTo(InAirFactor, Tuning.InAirSpread, DeltaTime, Tuning.InAirSpreadSpeed) : FMath::FInterpTo(InAirFactor, 0.f, DeltaTime, Tuning.LandedSpreadSpeed);
+
+	AimFactor = FMath::FInterpTo(AimFactor, bAiming ? Tuning.AimSpread : 0.f, DeltaTime, Tuning.AimSpreadSpeed);
+
+	// bFiringBullet is true for a short while after each shot
+	ShootingFactor = FMath::FInterpTo(ShootingFactor, bFiringBullet ? Tuning.ShootingSpread : 0.f, DeltaTime, Tuning.ShootingSpreadSpeed);
+}
+
+float FCrosshairSpread::GetMaxMultiplier(const FShooterTuning& Tuning)
+{
+	// each factor eases toward its target without passing it, and the velocity factor is clamped to 1
+	return 0.5f + 1.f + FMath::Max(Tuning.InAirSpread, 0.f) + FMath::Max(Tuning.ShootingSpread, 0.f);
+}
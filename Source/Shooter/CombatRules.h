@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AmmoType.h"
+
+struct FShooterTuning;
+
+/**
+ * Ammo and pickup bookkeeping shared by AShooterCharacter and AWeapon. Nothing here touches an actor,
+ * so the rules can be checked and timed without a world: the Shooter.Combat automation tests check them
+ * and the Shooter.Combat.Benchmark tests hold each one to a ns/op budget.
+ */
+struct SHOOTER_API FCombatRules
+{
+	// rounds a reload moves from the carried ammo into the magazine
+	static int32 GetReloadAmount(int32 MagazineAmmo, int32 MagazineCapacity, int32 CarriedAmmo);
+
+	// magazine count after firing one round; an empty magazine stays empty
+	static FORCEINLINE int32 GetAmmoAfterShot(int32 MagazineAmmo) { return FMath::Max(MagazineAmmo - 1, 0); }
+
+	static FORCEINLINE bool IsMagazineFull(int32 MagazineAmmo, int32 MagazineCapacity) { return MagazineAmmo >= MagazineCapacity; }
+
+	// carried rounds of AmmoType; zero when the type was never added
+	static int32 GetCarriedAmmo(const TMap<EAmmoType, int32>& AmmoMap, EAmmoType AmmoType);
+
+	// overlapped item count after adding Amount; never drops below zero or wraps past MAX_int8
+	static FORCEINLINE int8 GetOverlapCountAfter(int8 Count, int8 Amount) { return static_cast<int8>(FMath::Clamp(Count + Amount, 0, static_cast<int32>(MAX_int8))); }
+};
+
+/**
+ * The four parts of the crosshair spread. Each eases toward a target from FShooterTuning picked by how
+ * the character is moving and shooting, and the multiplier is their sum around a base of 0.5.
+ */
+struct SHOOTER_API FCrosshairSpread
+{
+	// eases every factor one frame toward its target; GroundSpeed ignores vertical velocity
+	void Update(const FShooterTuning& Tuning, float DeltaTime, float GroundSpeed, bool bInAir, bool bAiming, bool bFiringBullet);
+
+	FORCEINLINE float GetMultiplier() const { return 0.5f + VelocityFactor + InAirFactor - AimFactor + ShootingFactor; }
+
+	// largest multiplier the tuning allows: full speed, in the air and just fired, without aiming
+	static float GetMaxMultiplier(const FShooterTuning& Tuning);
+
+	float VelocityFactor = 0.f;
+	float InAirFactor = 0.f;
+	float AimFactor = 0.f;
+	float ShootingFactor = 0.f;
+};
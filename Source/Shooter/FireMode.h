@@ -0,0 +1,11 @@
+#pragma once
+
+UENUM(BlueprintType)
+enum class EFireMode : uint8
+{
+	EFM_SemiAuto UMETA(DisplayName = "SemiAuto"),
+	EFM_Burst UMETA(DisplayName = "Burst"),
+	EFM_FullAuto UMETA(DisplayName = "FullAuto"),
+
+	EFM_MAX UMETA(DisplayName = "DefaultMax")
+};
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FireScheduler.h"
+
+void FFireScheduler::PressTrigger(EFireMode FireMode, int32 BurstCount)
+{
+	bPressedFromIdle = !WantsShot();
+
+	switch (FireMode)
+	{
+	case EFireMode::EFM_SemiAuto:
+		PendingShots = FMath::Max(PendingShots, 1);
+		break;
+	case EFireMode::EFM_Burst:
+		// a burst runs to completion; pressing again mid burst doesn't extend it
+		PendingShots = FMath::Max(PendingShots, FMath::Max(1, BurstCount));
+		break;
+	case EFireMode::EFM_FullAuto:
+		bFullAuto = true;
+		break;
+	}
+}
+
+void FFireScheduler::ReleaseTrigger()
+{
+	bFullAuto = false;
+}
+
+void FFireScheduler::CancelShots()
+{
+	PendingShots = 0;
+	bFullAuto = false;
+}
+
+void FFireScheduler::Advance(float DeltaTime, float FireInterval, int32 MaxShots, FShotAges& OutShotAges)
+{
+	OutShotAges.Reset();
+
+	Cooldown -= DeltaTime;
+	if (bPressedFromIdle)
+	{
+		Cooldown = FMath::Max(Cooldown, 0.f);
+		bPressedFromIdle = false;
+	}
+
+	const int32 ShotLimit{ FMath::Min(MaxShots, MaxShotsPerAdvance) };
+	while (Cooldown <= 0.f && WantsShot() && OutShotAges.Num() < ShotLimit)
+	{
+		// the shot was due -Cooldown seconds ago, which is never before the start of this frame
+		OutShotAges.Add(FMath::Min(-Cooldown, DeltaTime));
+		Cooldown += FMath::Max(FireInterval, KINDA_SMALL_NUMBER);
+
+		if (PendingShots > 0)
+		{
+			--PendingShots;
+		}
+	}
+
+	// idle time and shots past the limit aren't banked, so the next shot can't come early
+	Cooldown = FMath::Max(Cooldown, 0.f);
+}
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FireMode.h"
+
+/**
+ * Decides when a weapon fires. Time accumulates across frames, so every shot that was due during a
+ * frame is emitted by that frame's Advance with its age, and the fire rate doesn't depend on the framerate.
+ */
+struct SHOOTER_API FFireScheduler
+{
+	// most shots one Advance emits; the rest of a long hitch is dropped rather than fired as a volley
+	static constexpr int32 MaxShotsPerAdvance = 8;
+
+	typedef TArray<float, TInlineAllocator<MaxShotsPerAdvance>> FShotAges;
+
+	// semi auto arms one shot, burst arms BurstCount, full auto fires until released
+	void PressTrigger(EFireMode FireMode, int32 BurstCount);
+	void ReleaseTrigger();
+
+	// drops armed shots, e.g. when the magazine runs dry; the cooldown of the last shot still runs
+	void CancelShots();
+
+	// advances by DeltaTime and writes the age in seconds of every shot due this frame, oldest first
+	void Advance(float DeltaTime, float FireInterval, int32 MaxShots, FShotAges& OutShotAges);
+
+	// true while shots are armed or the interval after the last shot hasn't elapsed
+	FORCEINLINE bool IsBusy() const { return WantsShot() || Cooldown > 0.f; }
+
+private:
+	FORCEINLINE bool WantsShot() const { return bFullAuto || PendingShots > 0; }
+
+	// seconds until the next shot may fire; negative while shots are owed
+	float Cooldown = 0.f;
+
+	// semi auto and burst shots still to fire
+	int32 PendingShots = 0;
+
+	bool bFullAuto = false;
+
+	// set by a press from idle; the first shot can't be owed from before the press
+	bool bPressedFromIdle = false;
+};
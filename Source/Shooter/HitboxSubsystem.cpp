@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitboxSubsystem.h"
+#include "Shooter.h"
+#include "ShooterHitboxComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Trace Hitboxes"), STAT_ShooterTraceHitboxes, STATGROUP_Shooter);
+
+void UHitboxSubsystem::RegisterHitboxes(UShooterHitboxComponent* HitboxComponent)
+{
+	HitboxComponents.AddUnique(HitboxComponent);
+}
+
+void UHitboxSubsystem::UnregisterHitboxes(UShooterHitboxComponent* HitboxComponent)
+{
+	HitboxComponents.RemoveSwap(HitboxComponent);
+}
+
+bool UHitboxSubsystem::TraceHitboxes(FHitResult& OutHitResult, const FVector& Start, const FVector& End, const AActor* IgnoredActor)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterTraceHitboxes);
+
+	PrepareHitboxes(TArrayView<const FVector>(&Start, 1), TArrayView<const FVector>(&End, 1), IgnoredActor);
+	return TraceHitboxesPrepared(OutHitResult, Start, End, IgnoredActor);
+}
+
+void UHitboxSubsystem::TraceHitboxesBatch(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, TArrayView<FHitResult> OutHitResults, const AActor* IgnoredActor)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterTraceHitboxes);
+	check(Starts.Num() == Ends.Num() && Ends.Num() == OutHitResults.Num());
+
+	PrepareHitboxes(Starts, Ends, IgnoredActor);
+
+	FHitResult HitboxHitResult;
+	for (int32 i = 0; i < Ends.Num(); i++)
+	{
+		if (TraceHitboxesPrepared(HitboxHitResult, Starts[i], Ends[i], IgnoredActor))
+		{
+			OutHitResults[i] = HitboxHitResult;
+		}
+	}
+}
+
+bool UHitboxSubsystem::TraceHitboxesPrepared(FHitResult& OutHitResult, const FVector& Start, const FVector& End, const AActor* IgnoredActor)
+{
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(IgnoredActor);
+	if (!GetWorld()->LineTraceSingleByChannel(OutHitResult, Start, End, ECC_Hitbox, QueryParams))
+	{
+		return false;
+	}
+
+	const AActor* HitActor = OutHitResult.GetActor();
+	if (const UShooterHitboxComponent* HitboxComponent = HitActor ? HitActor->FindComponentByClass<UShooterHitboxComponent>() : nullptr)
+	{
+		OutHitResult.BoneName = HitboxComponent->GetHitboxBoneName(OutHitResult.GetComponent());
+	}
+	return true;
+}
+
+void UHitboxSubsystem::PrepareHitboxes(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, const AActor* IgnoredActor)
+{
+	for (UShooterHitboxComponent* HitboxComponent : HitboxComponents)
+	{
+		const AActor* Owner = HitboxComponent ? HitboxComponent->GetOwner() : nullptr;
+		if (Owner == nullptr) continue;
+
+		bool bNearSegment{ false };
+		if (Owner != IgnoredActor)
+		{
+			const FVector OwnerLocation{ Owner->GetActorLocation() };
+			const float RadiusSquared{ FMath::Square(HitboxComponent->GetActivationRadius()) };
+			for (int32 i = 0; i < Ends.Num(); i++)
+			{
+				if (FMath::PointDistToSegmentSquared(OwnerLocation, Starts[i], Ends[i]) <= RadiusSquared)
+				{
+					bNearSegment = true;
+					break;
+				}
+			}
+		}
+
+		// hitboxes left where an earlier shot found them would still block where the owner used to stand
+		if (bNearSegment)
+		{
+			HitboxComponent->UpdateHitboxes();
+		}
+		else
+		{
+			HitboxComponent->DisableHitboxes();
+		}
+	}
+}
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HitboxSubsystem.generated.h"
+
+/**
+ * Tracks every hitbox component in the world and traces bullets against them,
+ * updating only the hitboxes of characters the shot passes near
+ */
+UCLASS()
+class SHOOTER_API UHitboxSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	void RegisterHitboxes(class UShooterHitboxComponent* HitboxComponent);
+	void UnregisterHitboxes(UShooterHitboxComponent* HitboxComponent);
+
+	// traces ECC_Hitbox from Start to End; OutHitResult.BoneName is set to the hit bone
+	bool TraceHitboxes(FHitResult& OutHitResult, const FVector& Start, const FVector& End, const AActor* IgnoredActor);
+
+	// traces a batch of segments, preparing hitboxes once for all of them;
+	// only overwrites the entries of OutHitResults that hit a hitbox
+	void TraceHitboxesBatch(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, TArrayView<FHitResult> OutHitResults, const AActor* IgnoredActor);
+
+private:
+	// brings the hitboxes of characters near the segments up to date with their pose and turns off the rest
+	void PrepareHitboxes(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, const AActor* IgnoredActor);
+
+	// ECC_Hitbox trace without preparing hitboxes
+	bool TraceHitboxesPrepared(FHitResult& OutHitResult, const FVector& Start, const FVector& End, const AActor* IgnoredActor);
+
+	UPROPERTY()
+	TArray<UShooterHitboxComponent*> HitboxComponents;
+};
@@ -3,44 +3,87 @@
 
 #include "Item.h"
 #include "Components/BoxComponent.h"
-#include "Components/WidgetComponent.h"
 #include "Components/SphereComponent.h"
 #include "ShooterCharacter.h"
 #include "Camera/CameraComponent.h"
+#include "ItemInterpSubsystem.h"
+#include "ItemRelevanceSubsystem.h"
+#include "PickupInstanceSubsystem.h"
+#include "Shooter.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sleeping Items"), STAT_ShooterSleepingItems, STATGROUP_Shooter);
+
+namespace
+{
+	// presentation shared by every item of a given rarity
+	struct FItemRarityVisuals
+	{
+		// bit N set when star N is shown; bit 0 is unused
+		uint8 StarMask;
+		float GlowColor[3];
+		float WidgetLightColor[3];
+		float WidgetDarkColor[3];
+	};
+
+	// indexed by EItemRarity
+	constexpr FItemRarityVisuals RarityVisuals[] =
+	{
+		// Damaged
+		{ 0b000010, { 0.4f, 0.4f, 0.4f }, { 0.5f, 0.5f, 0.5f }, { 0.1f, 0.1f, 0.1f } },
+		// Common
+		{ 0b000110, { 1.0f, 1.0f, 1.0f }, { 0.8f, 0.8f, 0.8f }, { 0.2f, 0.2f, 0.2f } },
+		// Uncommon
+		{ 0b001110, { 0.1f, 1.0f, 0.1f }, { 0.2f, 0.8f, 0.2f }, { 0.02f, 0.2f, 0.02f } },
+		// Rare
+		{ 0b011110, { 0.1f, 0.3f, 1.0f }, { 0.2f, 0.4f, 0.9f }, { 0.02f, 0.05f, 0.25f } },
+		// Legendary
+		{ 0b111110, { 1.0f, 0.6f, 0.0f }, { 1.0f, 0.7f, 0.1f }, { 0.3f, 0.15f, 0.0f } },
+	};
+	static_assert(UE_ARRAY_COUNT(RarityVisuals) == static_cast<int32>(EItemRarity::EIR_MAX), "RarityVisuals needs an entry per EItemRarity");
+
+	FORCEINLINE const FItemRarityVisuals& GetRarityVisuals(EItemRarity Rarity)
+	{
+		const int32 Index = FMath::Clamp(static_cast<int32>(Rarity), 0, static_cast<int32>(EItemRarity::EIR_MAX) - 1);
+		return RarityVisuals[Index];
+	}
+
+	FORCEINLINE FLinearColor ToLinearColor(const float (&Color)[3])
+	{
+		return FLinearColor(Color[0], Color[1], Color[2]);
+	}
+}
 
 // Sets default values
 AItem::AItem():
+	PickupWidgetOffset(FVector(0.f, 0.f, 50.f)),
 	ItemName(FString("Default")),
 	ItemCount(0),
 	ItemRarity(EItemRarity::EIR_Common),
 	ItemState(EItemState::EIS_Pickup),
 	// item interp variables
 	ZCurveTime(0.7f),
-	ItemInterpStartLocation(FVector(0.f)),
-	CameraTargetLocation(FVector(0.f)),
 	bInterping(false),
-	ItemInterpX(0.f),
-	ItemInterpY(0.f),
-	InterpInitialYawOffset(0.f)
+	bPooledDormant(false),
+	bRelevanceSleeping(false),
+	PickupInstanceIndex(INDEX_NONE)
 
 
 {
 	
 
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// item interping is advanced by UItemInterpSubsystem, so plain items never tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	ItemMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("ItemMesh"));
 	SetRootComponent(ItemMesh);
+	// no pose work while a pickup instance is drawn in its place
+	ItemMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
 
 	CollisionBox = CreateDefaultSubobject<UBoxComponent>(TEXT("CollisionBox"));
 	CollisionBox->SetupAttachment(ItemMesh);
 	CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 	CollisionBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
 
-	PickupWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("PickupWidget"));
-	PickupWidget->SetupAttachment(GetRootComponent());
-
 	AreaSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AreaSphere"));
 	AreaSphere->SetupAttachment(GetRootComponent());
 
@@ -51,15 +94,6 @@ void AItem::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// hide pickup widget
-	if (PickupWidget)
-	{
-		PickupWidget->SetVisibility(false);
-	}
-
-	// sets active stars array based on item rarity
-	SetActiveStars();
-
 	// set up overlap for area sphere
 	AreaSphere->OnComponentBeginOverlap.AddDynamic(this, &AItem::OnSphereOverlap);
 	AreaSphere->OnComponentEndOverlap.AddDynamic(this, &AItem::OnSphereEndOverlap);
@@ -67,6 +101,42 @@ void AItem::BeginPlay()
 	// Set Item properties based on ItemState
 	SetItemProperties(ItemState);
 
+	// bake the interp curves now rather than on pickup
+	if (UItemInterpSubsystem* InterpSubsystem = GetWorld()->GetSubsystem<UItemInterpSubsystem>())
+	{
+		InterpSubsystem->BakeCurve(ItemZCurve);
+		InterpSubsystem->BakeCurve(ItemScaleCurve);
+	}
+
+	// far away pickups are put to sleep until a player comes near
+	if (UItemRelevanceSubsystem* RelevanceSubsystem = GetWorld()->GetSubsystem<UItemRelevanceSubsystem>())
+	{
+		RelevanceSubsystem->RegisterItem(this);
+	}
+
+}
+
+void AItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UItemRelevanceSubsystem* RelevanceSubsystem = GetWorld()->GetSubsystem<UItemRelevanceSubsystem>())
+	{
+		RelevanceSubsystem->UnregisterItem(this);
+	}
+	if (bRelevanceSleeping)
+	{
+		DEC_DWORD_STAT(STAT_ShooterSleepingItems);
+	}
+	if (PickupInstanceIndex != INDEX_NONE)
+	{
+		if (UPickupInstanceSubsystem* InstanceSubsystem = GetWorld()->GetSubsystem<UPickupInstanceSubsystem>())
+		{
+			InstanceSubsystem->RemoveInstance(PickupStaticMesh, PickupInstanceIndex);
+		}
+		ItemMesh->TransformUpdated.RemoveAll(this);
+		PickupInstanceIndex = INDEX_NONE;
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AItem::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -93,42 +163,31 @@ void AItem::OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 	}
 }
 
-void AItem::SetActiveStars()
+int32 AItem::GetActiveStarMask() const
 {
-	// the 0 element isnt used
-	for (int32 i = 0; i <= 5; i++)
-	{
-		ActiveStars.Add(false);
-	}
+	return GetRarityVisuals(ItemRarity).StarMask;
+}
 
-	switch (ItemRarity)
-	{
-	case EItemRarity::EIR_Damaged:
-		ActiveStars[1] = true;
-		break;
-	case EItemRarity::EIR_Common:
-		ActiveStars[1] = true;
-		ActiveStars[2] = true;
-		break;
-	case EItemRarity::EIR_Uncommon:
-		ActiveStars[1] = true;
-		ActiveStars[2] = true;
-		ActiveStars[3] = true;
-		break;
-	case EItemRarity::EIR_Rare:
-		ActiveStars[1] = true;
-		ActiveStars[2] = true;
-		ActiveStars[3] = true;
-		ActiveStars[4] = true;
-		break;
-	case EItemRarity::EIR_Legendary:
-		ActiveStars[1] = true;
-		ActiveStars[2] = true;
-		ActiveStars[3] = true;
-		ActiveStars[4] = true;
-		ActiveStars[5] = true;
-		break;
-	}
+bool AItem::IsStarActive(int32 Star) const
+{
+	if (Star < 0 || Star > 5) return false;
+
+	return (GetRarityVisuals(ItemRarity).StarMask & (1 << Star)) != 0;
+}
+
+FLinearColor AItem::GetGlowColor() const
+{
+	return ToLinearColor(GetRarityVisuals(ItemRarity).GlowColor);
+}
+
+FLinearColor AItem::GetWidgetLightColor() const
+{
+	return ToLinearColor(GetRarityVisuals(ItemRarity).WidgetLightColor);
+}
+
+FLinearColor AItem::GetWidgetDarkColor() const
+{
+	return ToLinearColor(GetRarityVisuals(ItemRarity).WidgetDarkColor);
 }
 
 void AItem::SetItemProperties(EItemState State)
@@ -197,89 +256,63 @@ void AItem::SetItemProperties(EItemState State)
 			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 			break;
 	}
+
+	UpdatePickupRepresentation();
 }
 
-void AItem::FinishInterping()
+void AItem::UpdatePickupRepresentation()
 {
-	if (Character)
+	UPickupInstanceSubsystem* InstanceSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UPickupInstanceSubsystem>() : nullptr;
+	if (InstanceSubsystem == nullptr || PickupStaticMesh == nullptr) return;
+
+	// sleeping pickups keep their instance, so far loot stays visible at the cost of an instance
+	const bool bWantsInstance{ ItemState == EItemState::EIS_Pickup && !bPooledDormant && (HasActorBegunPlay() || IsActorBeginningPlay()) };
+	if (bWantsInstance && PickupInstanceIndex == INDEX_NONE)
 	{
-		Character->GetPickupItem(this);
+		PickupInstanceIndex = InstanceSubsystem->AddInstance(PickupStaticMesh, ItemMesh->GetComponentTransform());
+		ItemMesh->TransformUpdated.AddUObject(this, &AItem::OnItemMeshTransformUpdated);
 	}
-	// Set scale back to normal
-	SetActorScale3D(FVector(1.f));
+	else if (!bWantsInstance && PickupInstanceIndex != INDEX_NONE)
+	{
+		ItemMesh->TransformUpdated.RemoveAll(this);
+		InstanceSubsystem->RemoveInstance(PickupStaticMesh, PickupInstanceIndex);
+		PickupInstanceIndex = INDEX_NONE;
+	}
+
+	// the skeletal mesh is only drawn, and so only skinned, while there is no instance in its place
+	ItemMesh->SetVisibility(PickupInstanceIndex == INDEX_NONE);
 }
 
-void AItem::ItemInterp(float DeltaTime)
+void AItem::OnItemMeshTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
-	if (!bInterping || GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer) == -1.0f) return;
+	if (PickupInstanceIndex == INDEX_NONE) return;
 
-	if (Character && ItemZCurve)
+	if (UPickupInstanceSubsystem* InstanceSubsystem = GetWorld()->GetSubsystem<UPickupInstanceSubsystem>())
 	{
-		//elapsed time since we started ItemInterpTimer
-		const float ElapsedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer);
-		/*if (ElapsedTime == -1.0f)
-		{
-			bInterping = false;
-			return;
-		}*/
-		//Get curve value corresponding to ElapsedTime
-		const float CurveValue = ItemZCurve->GetFloatValue(ElapsedTime);
-
-		//Get the items initial location when the curve started
-		FVector ItemLocation = ItemInterpStartLocation;
-
-		//get the location in front of the camera
-		const FVector CameraInterpLocation{ Character->GetCameraInterpLocation() };
-
-		//vector from item to camera interp location, X and Y are zeroed out
-		const FVector ItemToCamera{ FVector(0.f, 0.f, (CameraInterpLocation - ItemLocation).Z) };
-
-		//scale factor to multiply with curve value
-		const float DeltaZ = ItemToCamera.Size();
-
-		const FVector CurrentLocation{ GetActorLocation() };
-
-		//interpolated X Value
-		const float InterpXValue = FMath::FInterpTo(CurrentLocation.X, CameraInterpLocation.X, DeltaTime, 30.0f);
-
-		//Interpolated Y Value
-		const float InterpYValue = FMath::FInterpTo(CurrentLocation.Y, CameraInterpLocation.Y, DeltaTime, 30.0f);
-
-		// set X and Y of ItemLocation to Interpolated Values
-		ItemLocation.X = InterpXValue;
-		ItemLocation.Y = InterpYValue;
-
-		//Adding Curve value to the Z component of the initial location (Scaled by DeltaZ)
-		ItemLocation.Z += CurveValue * DeltaZ;
-		SetActorLocation(ItemLocation, true, nullptr, ETeleportType::TeleportPhysics);
-
-		// camera rotation this frame
-		const FRotator CameraRotation{ Character->GetFollowCamera()->GetComponentRotation() };
-
-		//Camera rotation plus initial yaw offset
-		FRotator ItemRotation{ 0.f, CameraRotation.Yaw + InterpInitialYawOffset, 0.f };
-
-		SetActorRotation(ItemRotation, ETeleportType::TeleportPhysics);
-
-		if (ItemScaleCurve)
-		{
-			const float ScaleCurveValue = ItemScaleCurve->GetFloatValue(ElapsedTime);
-			SetActorScale3D(FVector(ScaleCurveValue, ScaleCurveValue, ScaleCurveValue));
-		}
-		
+		InstanceSubsystem->UpdateInstance(PickupStaticMesh, PickupInstanceIndex, ItemMesh->GetComponentTransform());
 	}
 }
 
-// Called every frame
-void AItem::Tick(float DeltaTime)
+void AItem::FinishInterping()
 {
-	Super::Tick(DeltaTime);
-	// handle item interping when in the EquipInterping state
-	ItemInterp(DeltaTime);
+	bInterping = false;
+
+	if (Character)
+	{
+		Character->GetPickupItem(this);
+	}
+	// Set scale back to normal
+	SetActorScale3D(FVector(1.f));
 }
 
 void AItem::SetItemState(EItemState State)
 {
+	// only pickups sleep; anything else needs its components
+	if (State != EItemState::EIS_Pickup)
+	{
+		SetRelevanceSleeping(false);
+	}
+
 	ItemState = State;
 	SetItemProperties(State);
 }
@@ -289,19 +322,70 @@ void AItem::StartItemCurve(AShooterCharacter* Char)
 	// store a handle to the character
 	Character = Char;
 
-	//Store initial location of the item
-	ItemInterpStartLocation = GetActorLocation();
 	bInterping = true;
 	SetItemState(EItemState::EIS_EquipInterping);
 
-	GetWorldTimerManager().SetTimer(ItemInterpTimer, this, &AItem::FinishInterping, ZCurveTime);
+	// nobody sees the item fly to the camera on a dedicated server
+	if (!ShooterShouldRunCosmetics(GetWorld()))
+	{
+		FinishInterping();
+		return;
+	}
+
+	// the subsystem advances the item every frame and calls FinishInterping after ZCurveTime
+	if (UItemInterpSubsystem* InterpSubsystem = GetWorld()->GetSubsystem<UItemInterpSubsystem>())
+	{
+		InterpSubsystem->StartInterp(this, Character, ItemZCurve, ItemScaleCurve, ZCurveTime);
+	}
+}
+
+void AItem::SetPooledDormant(bool bDormant)
+{
+	bPooledDormant = bDormant;
+
+	// an item released while asleep has its components unregistered; the pool's own dormancy takes over from here,
+	// and an acquired item needs its collision and mesh back
+	SetRelevanceSleeping(false);
+
+	SetActorHiddenInGame(bDormant);
+	SetActorEnableCollision(!bDormant);
+	if (PrimaryActorTick.bCanEverTick)
+	{
+		SetActorTickEnabled(!bDormant);
+	}
 
-	// get initial Yaw of the camera
-	const float CameraRotationYaw{ Character->GetFollowCamera()->GetComponentRotation().Yaw };
+	UpdatePickupRepresentation();
+}
+
+void AItem::SetRelevanceSleeping(bool bSleeping)
+{
+	if (bRelevanceSleeping == bSleeping) return;
+	bRelevanceSleeping = bSleeping;
 
-	//Get the initial yaw of the item
-	const float ItemRotationYaw{ GetActorRotation().Yaw };
+	if (bSleeping)
+	{
+		// drops the render proxy and physics bodies of every component
+		AreaSphere->UnregisterComponent();
+		CollisionBox->UnregisterComponent();
+		ItemMesh->UnregisterComponent();
+		INC_DWORD_STAT(STAT_ShooterSleepingItems);
+	}
+	else
+	{
+		// the root first so the children attach to a registered parent
+		ItemMesh->RegisterComponent();
+		CollisionBox->RegisterComponent();
+		AreaSphere->RegisterComponent();
+		AreaSphere->UpdateOverlaps();
+		DEC_DWORD_STAT(STAT_ShooterSleepingItems);
+	}
+}
 
-	//initial yaw offset between camera and item
-	InterpInitialYawOffset = ItemRotationYaw - CameraRotationYaw;
+void AItem::ResetForPool()
+{
+	Character = nullptr;
+	bInterping = false;
+	ItemRarity = GetClass()->GetDefaultObject<AItem>()->ItemRarity;
+	SetActorScale3D(FVector(1.f));
+	SetItemState(EItemState::EIS_Pickup);
 }
@@ -43,6 +43,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// called when overlapping area sphere
 	UFUNCTION()
 	void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -51,22 +53,9 @@ protected:
 	UFUNCTION()
 	void OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
-	// sets the ActiveStars array of bools based on rarity
-	void SetActiveStars();
-
 	//Sets properties of the Items Components based on state
 	void SetItemProperties(EItemState State);
 
-	//called when ItemInterpTimer is finished
-	void FinishInterping();
-
-	//handles item interpolation when in the EquipInterpingState
-	void ItemInterp(float DeltaTime);
-
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 private:
 	//skeletal mesh for the item
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
@@ -76,9 +65,9 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	class UBoxComponent* CollisionBox;
 
-	// pop up widget for when player looks at the item
+	// where the pooled pickup widget is shown, relative to the item
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
-	class UWidgetComponent* PickupWidget;
+	FVector PickupWidgetOffset;
 
 	// enables item tracing when overlapped 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
@@ -95,9 +84,6 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	EItemRarity ItemRarity;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
-	TArray<bool> ActiveStars;
-
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	EItemState ItemState;
 
@@ -105,21 +91,10 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	class UCurveFloat* ItemZCurve;
 
-	// starting location when interping begins 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
-	FVector ItemInterpStartLocation;
-
-	// Target interp location in front of the camera
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
-	FVector CameraTargetLocation;
-
 	//true when interping
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	bool bInterping;
 
-	// plays when we start interping
-	FTimerHandle ItemInterpTimer;
-
 	// duration of curve and time
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	float ZCurveTime;
@@ -128,13 +103,6 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	class AShooterCharacter* Character;
 
-	// X and Y for the Item while interping in the EquipInterping state
-	float ItemInterpX;
-	float ItemInterpY;
-
-	// initial yaw offset between the camera and the int
-	float InterpInitialYawOffset;
-
 	// Curve used to scale the item when interping
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	UCurveFloat* ItemScaleCurve;
@@ -146,8 +114,27 @@ private:
 	// sound played when the item is equipped
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	USoundCue* EquipSound;
+
+	// true while the item is sleeping in UPickupPoolSubsystem
+	bool bPooledDormant;
+
+	// true while UItemRelevanceSubsystem has the item asleep because no player is near
+	bool bRelevanceSleeping;
+
+	// drawn through UPickupInstanceSubsystem instead of ItemMesh while the item lies in the world as a pickup
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
+	class UStaticMesh* PickupStaticMesh;
+
+	// index of this item's instance in UPickupInstanceSubsystem, INDEX_NONE while ItemMesh is drawn
+	int32 PickupInstanceIndex;
+
+	// swaps between the pickup instance and ItemMesh to match the item state
+	void UpdatePickupRepresentation();
+
+	// bound to ItemMesh while the pickup instance is drawn, so the instance follows every move
+	void OnItemMeshTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
 public:
-	FORCEINLINE UWidgetComponent* GetPickupWidget() const { return PickupWidget; }
+	FORCEINLINE FVector GetPickupWidgetOffset() const { return PickupWidgetOffset; }
 	FORCEINLINE USphereComponent* GetAreaSphere() const { return AreaSphere; }
 	FORCEINLINE UBoxComponent* GetCollisionBox() const { return CollisionBox; }
 	FORCEINLINE EItemState GetItemState() const { return ItemState; }
@@ -155,7 +142,42 @@ public:
 	FORCEINLINE USkeletalMeshComponent* GetItemMesh() const { return ItemMesh; }
 	FORCEINLINE USoundCue* GetPickUpSound() const { return PickUpSound; }
 	FORCEINLINE USoundCue* GetEquipSound() const { return EquipSound; }
+	FORCEINLINE EItemRarity GetItemRarity() const { return ItemRarity; }
+	FORCEINLINE void SetItemRarity(EItemRarity Rarity) { ItemRarity = Rarity; }
+
+	// bit N is set when star N is shown in the pickup widget (bit 0 is unused)
+	UFUNCTION(BlueprintPure, Category = "Item Properties")
+	int32 GetActiveStarMask() const;
+
+	// true if star number Star (1-5) is shown for this rarity
+	UFUNCTION(BlueprintPure, Category = "Item Properties")
+	bool IsStarActive(int32 Star) const;
+
+	// glow colour of the item for its rarity
+	UFUNCTION(BlueprintPure, Category = "Item Properties")
+	FLinearColor GetGlowColor() const;
+
+	// light and dark background colours of the pickup widget for this rarity
+	UFUNCTION(BlueprintPure, Category = "Item Properties")
+	FLinearColor GetWidgetLightColor() const;
+
+	UFUNCTION(BlueprintPure, Category = "Item Properties")
+	FLinearColor GetWidgetDarkColor() const;
 
 	// called from the AShooterCharacter class
 	void StartItemCurve(AShooterCharacter* Char);
+
+	//called by UItemInterpSubsystem when the interp curve has finished
+	void FinishInterping();
+
+	// hides the item and disables its collision and tick while it waits in the pickup pool
+	void SetPooledDormant(bool bDormant);
+	FORCEINLINE bool IsPooledDormant() const { return bPooledDormant; }
+
+	// unregisters the item's components while no player is near and registers them again on waking
+	void SetRelevanceSleeping(bool bSleeping);
+	FORCEINLINE bool IsRelevanceSleeping() const { return bRelevanceSleeping; }
+
+	// restores per-instance state before the item goes back to the pool
+	virtual void ResetForPool();
 };
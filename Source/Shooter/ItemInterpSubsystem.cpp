@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemInterpSubsystem.h"
+#include "Item.h"
+#include "ShooterCharacter.h"
+#include "Camera/CameraComponent.h"
+#include "Curves/CurveFloat.h"
+
+void FBakedCurve::Bake(const UCurveFloat* Curve)
+{
+	Curve->GetTimeRange(MinTime, MaxTime);
+
+	const float Step = (MaxTime - MinTime) / (NumSamples - 1);
+	InvStep = Step > 0.f ? 1.f / Step : 0.f;
+
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		Samples[i] = Curve->GetFloatValue(MinTime + Step * i);
+	}
+}
+
+float FBakedCurve::Sample(float Time) const
+{
+	const float Position = FMath::Clamp((Time - MinTime) * InvStep, 0.f, static_cast<float>(NumSamples - 1));
+	const int32 Index = FMath::Min(FMath::FloorToInt(Position), NumSamples - 2);
+	return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+}
+
+int32 UItemInterpSubsystem::BakeCurve(UCurveFloat* Curve)
+{
+	if (Curve == nullptr) return INDEX_NONE;
+
+	if (const int32* Index = CurveIndices.Find(Curve))
+	{
+		return *Index;
+	}
+
+	const int32 Index = BakedCurves.AddDefaulted();
+	BakedCurves[Index].Bake(Curve);
+	CurveIndices.Add(Curve, Index);
+	return Index;
+}
+
+void UItemInterpSubsystem::StartInterp(AItem* Item, AShooterCharacter* Character, UCurveFloat* ZCurve, UCurveFloat* ScaleCurve, float Duration)
+{
+	if (Item == nullptr || Character == nullptr) return;
+
+	// already on its way (e.g. select pressed twice); a second entry would finish the item twice
+	const bool bAlreadyInFlight = InFlight.ContainsByPredicate([Item](const FItemInterpEntry& InFlightEntry) { return InFlightEntry.Item == Item; });
+	if (bAlreadyInFlight) return;
+
+	FItemInterpEntry& Entry = InFlight.AddDefaulted_GetRef();
+	Entry.Item = Item;
+	Entry.Character = Character;
+	Entry.StartLocation = Item->GetActorLocation();
+	Entry.CurrentLocation = Entry.StartLocation;
+	Entry.ElapsedTime = 0.f;
+	Entry.Duration = Duration;
+	Entry.ZCurveIndex = BakeCurve(ZCurve);
+	Entry.ScaleCurveIndex = BakeCurve(ScaleCurve);
+
+	//initial yaw offset between camera and item
+	Entry.InitialYawOffset = Item->GetActorRotation().Yaw - Character->GetFollowCamera()->GetComponentRotation().Yaw;
+}
+
+void UItemInterpSubsystem::Tick(float DeltaTime)
+{
+	// camera values are shared by every item flying to the same character
+	const AShooterCharacter* CachedCharacter{ nullptr };
+	FVector CameraInterpLocation{ FVector::ZeroVector };
+	float CameraYaw{ 0.f };
+
+	for (int32 i = InFlight.Num() - 1; i >= 0; i--)
+	{
+		FItemInterpEntry& Entry = InFlight[i];
+		AItem* Item = Entry.Item.Get();
+		AShooterCharacter* Character = Entry.Character.Get();
+		if (Item == nullptr || Character == nullptr)
+		{
+			InFlight.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		Entry.ElapsedTime += DeltaTime;
+		if (Entry.ElapsedTime >= Entry.Duration)
+		{
+			Finished.Add(Item);
+			InFlight.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		if (Character != CachedCharacter)
+		{
+			CachedCharacter = Character;
+			CameraInterpLocation = Character->GetCameraInterpLocation();
+			CameraYaw = Character->GetFollowCamera()->GetComponentRotation().Yaw;
+		}
+
+		if (Entry.ZCurveIndex != INDEX_NONE)
+		{
+			const float CurveValue = BakedCurves[Entry.ZCurveIndex].Sample(Entry.ElapsedTime);
+
+			//scale factor to multiply with curve value
+			const float DeltaZ = FMath::Abs(CameraInterpLocation.Z - Entry.StartLocation.Z);
+
+			Entry.CurrentLocation.X = FMath::FInterpTo(Entry.CurrentLocation.X, CameraInterpLocation.X, DeltaTime, 30.0f);
+			Entry.CurrentLocation.Y = FMath::FInterpTo(Entry.CurrentLocation.Y, CameraInterpLocation.Y, DeltaTime, 30.0f);
+			Entry.CurrentLocation.Z = Entry.StartLocation.Z + CurveValue * DeltaZ;
+
+			// purely cosmetic, so no sweep
+			Item->SetActorLocationAndRotation(Entry.CurrentLocation, FRotator(0.f, CameraYaw + Entry.InitialYawOffset, 0.f), false, nullptr, ETeleportType::TeleportPhysics);
+		}
+
+		if (Entry.ScaleCurveIndex != INDEX_NONE)
+		{
+			const float ScaleCurveValue = BakedCurves[Entry.ScaleCurveIndex].Sample(Entry.ElapsedTime);
+			Item->SetActorScale3D(FVector(ScaleCurveValue));
+		}
+	}
+
+	for (const TWeakObjectPtr<AItem>& FinishedItem : Finished)
+	{
+		if (FinishedItem.IsValid())
+		{
+			FinishedItem->FinishInterping();
+		}
+	}
+	Finished.Reset();
+}
+
+ETickableTickType UItemInterpSubsystem::GetTickableTickType() const
+{
+	// the CDO never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UItemInterpSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemInterpSubsystem, STATGROUP_Tickables);
+}
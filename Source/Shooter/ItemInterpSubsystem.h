@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ItemInterpSubsystem.generated.h"
+
+// a float curve sampled at a fixed resolution, evaluated with a single lerp
+struct FBakedCurve
+{
+	static constexpr int32 NumSamples = 64;
+
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	float InvStep = 0.f;
+	float Samples[NumSamples];
+
+	void Bake(const class UCurveFloat* Curve);
+	float Sample(float Time) const;
+};
+
+// one item flying towards the camera after being picked up
+struct FItemInterpEntry
+{
+	TWeakObjectPtr<class AItem> Item;
+	TWeakObjectPtr<class AShooterCharacter> Character;
+	FVector StartLocation;
+	FVector CurrentLocation;
+	float InitialYawOffset;
+	float ElapsedTime;
+	float Duration;
+	int32 ZCurveIndex;
+	int32 ScaleCurveIndex;
+};
+
+/**
+ * Advances every in-flight item pickup in one batch per frame, using curves baked at load time
+ */
+UCLASS()
+class SHOOTER_API UItemInterpSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	// bakes the curve into a lookup table if it hasn't been already; returns INDEX_NONE for a null curve
+	int32 BakeCurve(class UCurveFloat* Curve);
+
+	// starts interping the item towards the character's camera; ignored if the item is already interping
+	void StartInterp(AItem* Item, AShooterCharacter* Character, UCurveFloat* ZCurve, UCurveFloat* ScaleCurve, float Duration);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return InFlight.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	// maps each curve asset to its entry in BakedCurves
+	UPROPERTY()
+	TMap<UCurveFloat*, int32> CurveIndices;
+
+	TArray<FBakedCurve> BakedCurves;
+
+	// items currently interping, packed contiguously
+	TArray<FItemInterpEntry> InFlight;
+
+	// items that finished this frame; notified after the batch so callbacks can't touch InFlight
+	TArray<TWeakObjectPtr<AItem>> Finished;
+};
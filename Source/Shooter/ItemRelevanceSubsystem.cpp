@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemRelevanceSubsystem.h"
+#include "Shooter.h"
+#include "Item.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Item Relevance"), STAT_ShooterItemRelevance, STATGROUP_Shooter);
+
+namespace
+{
+	// items checked per frame; a full sweep of N items takes N / ItemsPerFrame frames
+	constexpr int32 ItemsPerFrame = 128;
+
+	// items sleep beyond SleepDistance and wake inside WakeDistance; the gap keeps them from flickering,
+	// and WakeDistance leaves room for a sprinting player to cover a whole sweep before reaching the item
+	constexpr float SleepDistance = 8'000.f;
+	constexpr float WakeDistance = 6'000.f;
+}
+
+void UItemRelevanceSubsystem::RegisterItem(AItem* Item)
+{
+	if (Item == nullptr || ItemIndices.Contains(Item)) return;
+
+	ItemIndices.Add(Item, Items.Add(Item));
+}
+
+void UItemRelevanceSubsystem::UnregisterItem(AItem* Item)
+{
+	int32 Index{ INDEX_NONE };
+	if (!ItemIndices.RemoveAndCopyValue(Item, Index)) return;
+
+	// the last item takes the removed one's slot
+	Items.RemoveAtSwap(Index, 1, false);
+	if (Items.IsValidIndex(Index) && Items[Index])
+	{
+		ItemIndices.Add(Items[Index], Index);
+	}
+}
+
+void UItemRelevanceSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterItemRelevance);
+
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+	// no players yet, nothing to measure against
+	if (PlayerLocations.Num() == 0) return;
+
+	const int32 NumToCheck{ FMath::Min(ItemsPerFrame, Items.Num()) };
+	for (int32 Checked = 0; Checked < NumToCheck; Checked++)
+	{
+		if (NextItemIndex >= Items.Num())
+		{
+			NextItemIndex = 0;
+		}
+		AItem* Item = Items[NextItemIndex++];
+
+		// only pickups lying in the world sleep; pooled items are already dormant
+		if (Item == nullptr || Item->IsPooledDormant() || Item->GetItemState() != EItemState::EIS_Pickup) continue;
+
+		float MinDistanceSquared{ TNumericLimits<float>::Max() };
+		const FVector ItemLocation{ Item->GetActorLocation() };
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(ItemLocation, PlayerLocation));
+		}
+
+		if (!Item->IsRelevanceSleeping() && MinDistanceSquared > FMath::Square(SleepDistance))
+		{
+			Item->SetRelevanceSleeping(true);
+		}
+		else if (Item->IsRelevanceSleeping() && MinDistanceSquared < FMath::Square(WakeDistance))
+		{
+			Item->SetRelevanceSleeping(false);
+		}
+	}
+}
+
+ETickableTickType UItemRelevanceSubsystem::GetTickableTickType() const
+{
+	// the class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UItemRelevanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemRelevanceSubsystem, STATGROUP_Tickables);
+}
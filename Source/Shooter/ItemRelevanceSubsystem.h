@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ItemRelevanceSubsystem.generated.h"
+
+/**
+ * Puts pickups that are far from every player to sleep and wakes them as players approach.
+ * Each frame checks a fixed number of items, so the cost doesn't grow with the number of pickups in the map
+ */
+UCLASS()
+class SHOOTER_API UItemRelevanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	void RegisterItem(class AItem* Item);
+	void UnregisterItem(AItem* Item);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return Items.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	UPROPERTY()
+	TArray<AItem*> Items;
+
+	// slot of each registered item in Items, so registering and unregistering don't search the array
+	TMap<const AItem*, int32> ItemIndices;
+
+	// where the next frame's slice starts
+	int32 NextItemIndex = 0;
+
+	// pawn locations of every player, gathered once per frame
+	TArray<FVector> PlayerLocations;
+};
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PickupInstanceSubsystem.h"
+#include "Shooter.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickup Instances"), STAT_ShooterPickupInstances, STATGROUP_Shooter);
+
+namespace
+{
+	// a zero scale instance draws nothing and is culled by the cluster tree
+	const FTransform HiddenInstanceTransform{ FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector };
+}
+
+bool UPickupInstanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_SERVER
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+int32 UPickupInstanceSubsystem::AddInstance(UStaticMesh* Mesh, const FTransform& Transform)
+{
+	UHierarchicalInstancedStaticMeshComponent* InstanceComponent = FindOrAddComponent(Mesh);
+	if (InstanceComponent == nullptr) return INDEX_NONE;
+
+	INC_DWORD_STAT(STAT_ShooterPickupInstances);
+
+	TArray<int32>& Free = FreeInstances.FindOrAdd(Mesh);
+	if (Free.Num() > 0)
+	{
+		const int32 InstanceIndex{ Free.Pop(false) };
+		InstanceComponent->UpdateInstanceTransform(InstanceIndex, Transform, true, true, true);
+		return InstanceIndex;
+	}
+	return InstanceComponent->AddInstanceWorldSpace(Transform);
+}
+
+void UPickupInstanceSubsystem::UpdateInstance(UStaticMesh* Mesh, int32 InstanceIndex, const FTransform& Transform)
+{
+	UHierarchicalInstancedStaticMeshComponent** InstanceComponent = InstanceComponents.Find(Mesh);
+	if (InstanceComponent == nullptr || *InstanceComponent == nullptr || InstanceIndex == INDEX_NONE) return;
+
+	(*InstanceComponent)->UpdateInstanceTransform(InstanceIndex, Transform, true, true, true);
+}
+
+void UPickupInstanceSubsystem::RemoveInstance(UStaticMesh* Mesh, int32 InstanceIndex)
+{
+	UHierarchicalInstancedStaticMeshComponent** InstanceComponent = InstanceComponents.Find(Mesh);
+	if (InstanceComponent == nullptr || *InstanceComponent == nullptr || InstanceIndex == INDEX_NONE) return;
+
+	DEC_DWORD_STAT(STAT_ShooterPickupInstances);
+
+	(*InstanceComponent)->UpdateInstanceTransform(InstanceIndex, HiddenInstanceTransform, true, true, true);
+	FreeInstances.FindOrAdd(Mesh).Add(InstanceIndex);
+}
+
+UHierarchicalInstancedStaticMeshComponent* UPickupInstanceSubsystem::FindOrAddComponent(UStaticMesh* Mesh)
+{
+	if (Mesh == nullptr) return nullptr;
+
+	if (UHierarchicalInstancedStaticMeshComponent** Found = InstanceComponents.Find(Mesh))
+	{
+		return *Found;
+	}
+
+	if (InstanceHost == nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		InstanceHost = GetWorld()->SpawnActor<AActor>(SpawnParams);
+
+		USceneComponent* Root = NewObject<USceneComponent>(InstanceHost, TEXT("Root"));
+		InstanceHost->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UHierarchicalInstancedStaticMeshComponent* InstanceComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstanceHost);
+	InstanceComponent->SetStaticMesh(Mesh);
+	// item traces hit the item's own collision box
+	InstanceComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	InstanceComponent->SetupAttachment(InstanceHost->GetRootComponent());
+	InstanceComponent->RegisterComponent();
+	InstanceHost->AddInstanceComponent(InstanceComponent);
+
+	InstanceComponents.Add(Mesh, InstanceComponent);
+	return InstanceComponent;
+}
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PickupInstanceSubsystem.generated.h"
+
+/**
+ * Draws pickups lying in the world as instances of one hierarchical instanced static mesh per item mesh,
+ * so ground loot costs a handful of draw calls and no skinning
+ */
+UCLASS()
+class SHOOTER_API UPickupInstanceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	// never created in server builds
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// returns the instance index used to remove the instance later
+	int32 AddInstance(class UStaticMesh* Mesh, const FTransform& Transform);
+	void UpdateInstance(UStaticMesh* Mesh, int32 InstanceIndex, const FTransform& Transform);
+	void RemoveInstance(UStaticMesh* Mesh, int32 InstanceIndex);
+
+private:
+	class UHierarchicalInstancedStaticMeshComponent* FindOrAddComponent(UStaticMesh* Mesh);
+
+	// transient actor owning the instanced components; destroyed with the world
+	UPROPERTY()
+	AActor* InstanceHost;
+
+	UPROPERTY()
+	TMap<UStaticMesh*, UHierarchicalInstancedStaticMeshComponent*> InstanceComponents;
+
+	// removed instances are collapsed and reused rather than removed, which would reorder the instances
+	TMap<UStaticMesh*, TArray<int32>> FreeInstances;
+};
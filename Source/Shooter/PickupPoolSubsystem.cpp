@@ -0,0 +1,231 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PickupPoolSubsystem.h"
+#include "Item.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Shooter.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Recycled Dropped Items"), STAT_ShooterRecycledDroppedItems, STATGROUP_Shooter);
+
+static TAutoConsoleVariable<int32> CVarDroppedItemBudget(
+	TEXT("shooter.Pickups.DroppedItemBudget"),
+	1,
+	TEXT("0 leaves dropped items in the world instead of recycling them by count and age, for comparing GC pauses in the soak test."));
+
+namespace
+{
+	// still lying in the world where a character left it
+	bool IsAbandoned(const AItem* Item)
+	{
+		if (Item == nullptr || Item->IsPendingKill() || Item->IsPooledDormant()) return false;
+		return Item->GetItemState() == EItemState::EIS_Pickup || Item->GetItemState() == EItemState::EIS_Falling;
+	}
+}
+
+UPickupPoolSubsystem::UPickupPoolSubsystem() :
+	MaxWarmSpawnsPerFrame(2),
+	SublevelWarmCount(2),
+	MaxDroppedItems(32),
+	MaxDroppedItemAge(120.f)
+{
+
+}
+
+void UPickupPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UPickupPoolSubsystem::OnLevelAddedToWorld);
+}
+
+void UPickupPoolSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	PendingWarm.Reset();
+	Pools.Reset();
+	DroppedItems.Reset();
+
+	Super::Deinitialize();
+}
+
+void UPickupPoolSubsystem::WarmPool(TSubclassOf<AItem> ItemClass, int32 Count)
+{
+	if (ItemClass == nullptr || Count <= 0) return;
+
+	for (TPair<TSubclassOf<AItem>, int32>& Pending : PendingWarm)
+	{
+		if (Pending.Key == ItemClass)
+		{
+			Pending.Value = FMath::Max(Pending.Value, Count);
+			return;
+		}
+	}
+	PendingWarm.Emplace(ItemClass, Count);
+}
+
+AItem* UPickupPoolSubsystem::AcquireItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform)
+{
+	if (ItemClass == nullptr) return nullptr;
+
+	AItem* Item{ nullptr };
+	if (FPickupPool* Pool = Pools.Find(ItemClass))
+	{
+		// skip anything destroyed, or on its way out, while it was dormant
+		while (!IsValid(Item) && Pool->DormantItems.Num() > 0)
+		{
+			Item = Pool->DormantItems.Pop(false);
+		}
+	}
+
+	if (!IsValid(Item))
+	{
+		// pool is empty, fall back to a regular spawn
+		return GetWorld()->SpawnActor<AItem>(ItemClass, Transform);
+	}
+
+	Item->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Item->SetPooledDormant(false);
+	return Item;
+}
+
+void UPickupPoolSubsystem::ReleaseItem(AItem* Item)
+{
+	if (Item == nullptr || Item->IsPooledDormant()) return;
+
+	Item->ResetForPool();
+	Item->SetPooledDormant(true);
+	Pools.FindOrAdd(Item->GetClass()).DormantItems.Add(Item);
+}
+
+int32 UPickupPoolSubsystem::GetNumDormant(TSubclassOf<AItem> ItemClass) const
+{
+	const FPickupPool* Pool = Pools.Find(ItemClass);
+	return Pool ? Pool->DormantItems.Num() : 0;
+}
+
+void UPickupPoolSubsystem::TrackDroppedItem(AItem* Item)
+{
+	if (!IsAbandoned(Item)) return;
+	if (CVarDroppedItemBudget.GetValueOnGameThread() == 0) return;
+
+	// an item dropped again starts its age over
+	DroppedItems.RemoveAll([Item](const FDroppedItem& Dropped) { return Dropped.Item == Item; });
+	PruneDroppedItems();
+
+	FDroppedItem& Dropped = DroppedItems.AddDefaulted_GetRef();
+	Dropped.Item = Item;
+	Dropped.DropTime = GetWorld()->GetTimeSeconds();
+
+	while (DroppedItems.Num() > MaxDroppedItems)
+	{
+		AItem* Oldest = DroppedItems[0].Item;
+		DroppedItems.RemoveAt(0, 1, false);
+
+		ReleaseItem(Oldest);
+		INC_DWORD_STAT(STAT_ShooterRecycledDroppedItems);
+	}
+}
+
+void UPickupPoolSubsystem::PruneDroppedItems()
+{
+	DroppedItems.RemoveAll([](const FDroppedItem& Dropped) { return !IsAbandoned(Dropped.Item); });
+}
+
+void UPickupPoolSubsystem::FlushPendingWarm()
+{
+	WarmPending(MAX_int32);
+}
+
+void UPickupPoolSubsystem::WarmPending(int32 SpawnBudget)
+{
+	while (SpawnBudget > 0 && PendingWarm.Num() > 0)
+	{
+		TPair<TSubclassOf<AItem>, int32>& Pending = PendingWarm[0];
+		FPickupPool& Pool = Pools.FindOrAdd(Pending.Key);
+
+		if (Pool.DormantItems.Num() >= Pending.Value)
+		{
+			PendingWarm.RemoveAt(0, 1, false);
+			continue;
+		}
+
+		if (AItem* Item = SpawnDormantItem(Pending.Key))
+		{
+			Pool.DormantItems.Add(Item);
+		}
+		else
+		{
+			// class can't be spawned, give up on it
+			PendingWarm.RemoveAt(0, 1, false);
+		}
+		--SpawnBudget;
+	}
+}
+
+void UPickupPoolSubsystem::Tick(float DeltaTime)
+{
+	WarmPending(MaxWarmSpawnsPerFrame);
+
+	if (CVarDroppedItemBudget.GetValueOnGameThread() == 0) return;
+
+	// items are tracked in drop order, so only the front can have run out of time
+	const float Now{ GetWorld()->GetTimeSeconds() };
+	while (DroppedItems.Num() > 0)
+	{
+		const FDroppedItem& Oldest = DroppedItems[0];
+		if (IsAbandoned(Oldest.Item))
+		{
+			if (Now - Oldest.DropTime < MaxDroppedItemAge) break;
+
+			ReleaseItem(Oldest.Item);
+			INC_DWORD_STAT(STAT_ShooterRecycledDroppedItems);
+		}
+		DroppedItems.RemoveAt(0, 1, false);
+	}
+}
+
+ETickableTickType UPickupPoolSubsystem::GetTickableTickType() const
+{
+	// the CDO never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UPickupPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPickupPoolSubsystem, STATGROUP_Tickables);
+}
+
+void UPickupPoolSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || Level == nullptr || Level->IsPersistentLevel()) return;
+
+	// warm a few dormant items for every item class placed in the incoming sublevel
+	TSet<UClass*> ItemClasses;
+	for (AActor* Actor : Level->Actors)
+	{
+		if (AItem* Item = Cast<AItem>(Actor))
+		{
+			ItemClasses.Add(Item->GetClass());
+		}
+	}
+
+	for (UClass* ItemClass : ItemClasses)
+	{
+		WarmPool(ItemClass, SublevelWarmCount);
+	}
+}
+
+AItem* UPickupPoolSubsystem::SpawnDormantItem(TSubclassOf<AItem> ItemClass)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AItem* Item = GetWorld()->SpawnActor<AItem>(ItemClass, FTransform::Identity, SpawnParams);
+	if (Item)
+	{
+		Item->SetPooledDormant(true);
+	}
+	return Item;
+}
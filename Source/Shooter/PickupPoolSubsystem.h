@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "PickupPoolSubsystem.generated.h"
+
+// dormant actors of one item class
+USTRUCT()
+struct FPickupPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<class AItem*> DormantItems;
+};
+
+// an item thrown away by a character, and the world time it hit the ground budget
+USTRUCT()
+struct FDroppedItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AItem* Item = nullptr;
+
+	float DropTime = 0.f;
+};
+
+/**
+ * Pre-spawns dormant items per class and hands them out for spawns and drops, so combat never pays for SpawnActor.
+ * The map's pools are warmed while it loads; sublevels streamed in later are warmed time sliced.
+ * Dropped items are budgeted by count and age; the oldest ones left lying around go back to the pool.
+ */
+UCLASS()
+class SHOOTER_API UPickupPoolSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	UPickupPoolSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// queues dormant items so the pool for ItemClass holds at least Count; spawned a few per frame
+	void WarmPool(TSubclassOf<AItem> ItemClass, int32 Count);
+
+	// spawns everything still queued for warming right away; for loading, before gameplay starts
+	void FlushPendingWarm();
+
+	// takes a dormant item from the pool (or spawns one if it's empty) and places it at Transform
+	AItem* AcquireItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform);
+
+	template<typename T>
+	T* AcquireItem(TSubclassOf<T> ItemClass, const FTransform& Transform)
+	{
+		return Cast<T>(AcquireItem(TSubclassOf<AItem>(ItemClass), Transform));
+	}
+
+	// puts the item to sleep and returns it to the pool for its class
+	void ReleaseItem(AItem* Item);
+
+	int32 GetNumDormant(TSubclassOf<AItem> ItemClass) const;
+
+	// counts a dropped item against the budget; over budget, the oldest dropped item is recycled
+	void TrackDroppedItem(AItem* Item);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return PendingWarm.Num() > 0 || DroppedItems.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	// called for every level added to any world; warms pools for the items placed in sublevels of ours
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+	AItem* SpawnDormantItem(TSubclassOf<AItem> ItemClass);
+
+	// spawns up to SpawnBudget queued dormant items
+	void WarmPending(int32 SpawnBudget);
+
+	// drops tracked items that were picked up again, recycled or destroyed
+	void PruneDroppedItems();
+
+	UPROPERTY()
+	TMap<TSubclassOf<AItem>, FPickupPool> Pools;
+
+	// classes still waiting to be warmed, with the pool size they should reach
+	TArray<TPair<TSubclassOf<AItem>, int32>> PendingWarm;
+
+	// max dormant items spawned per frame while warming
+	int32 MaxWarmSpawnsPerFrame;
+
+	// dormant items kept per item class found in a streamed in sublevel
+	int32 SublevelWarmCount;
+
+	// dropped items still lying in the world, oldest first
+	UPROPERTY()
+	TArray<FDroppedItem> DroppedItems;
+
+	// most dropped items allowed in the world at once. shooter.Pickups.DroppedItemBudget 0 lifts this and the age limit,
+	// so the Shooter.Soak.LeakAndGC automation test can report the p99 GC pause with and without the budget
+	int32 MaxDroppedItems;
+
+	// seconds a dropped item may lie untouched before it is recycled
+	float MaxDroppedItemAge;
+
+	FDelegateHandle LevelAddedHandle;
+};
@@ -0,0 +1,16 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PickupWidget.h"
+#include "Item.h"
+
+void UPickupWidget::SetItem(AItem* InItem)
+{
+	if (Item == InItem) return;
+
+	Item = InItem;
+	if (Item)
+	{
+		OnItemChanged();
+	}
+}
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "PickupWidget.generated.h"
+
+/**
+ * Base class for the pooled pickup widget. The player controller binds it to whichever item is focused.
+ */
+UCLASS()
+class SHOOTER_API UPickupWidget : public UUserWidget
+{
+	GENERATED_BODY()
+public:
+	// binds the widget to an item; nullptr when returned to the pool
+	void SetItem(class AItem* InItem);
+
+	FORCEINLINE AItem* GetItem() const { return Item; }
+
+protected:
+	// called after the widget is bound to a new item so the blueprint can refresh name, count and stars
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnItemChanged();
+
+private:
+	// item the widget currently displays
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
+	AItem* Item;
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SShooterCrosshair.h"
+#include "Shooter.h"
+#include "CombatRules.h"
+#include "ShooterTuningSettings.h"
+#include "Rendering/DrawElements.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crosshair Paint"), STAT_ShooterCrosshairPaint, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crosshair Repaints"), STAT_ShooterCrosshairRepaints, STATGROUP_Shooter);
+
+void SShooterCrosshair::Construct(const FArguments& InArgs)
+{
+	BaseSpread = InArgs._BaseSpread;
+	SpreadScale = InArgs._SpreadScale;
+	TickLength = InArgs._TickLength;
+	TickThickness = InArgs._TickThickness;
+	Color = InArgs._Color;
+	SpreadMultiplier = 0.f;
+}
+
+void SShooterCrosshair::SetSpreadMultiplier(float InSpreadMultiplier)
+{
+	if (SpreadMultiplier == InSpreadMultiplier) return;
+
+	SpreadMultiplier = InSpreadMultiplier;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SShooterCrosshair::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCrosshairPaint);
+	INC_DWORD_STAT(STAT_ShooterCrosshairRepaints);
+
+	const FVector2D Center{ AllottedGeometry.GetLocalSize() * 0.5f };
+	const float Offset{ BaseSpread + SpreadScale * SpreadMultiplier };
+
+	// left, right, top, bottom
+	static const FVector2D Directions[] = { FVector2D(-1.f, 0.f), FVector2D(1.f, 0.f), FVector2D(0.f, -1.f), FVector2D(0.f, 1.f) };
+
+	const FLinearColor TickColor{ InWidgetStyle.GetColorAndOpacityTint() * Color };
+	TArray<FVector2D> Points;
+	Points.SetNumUninitialized(2);
+	for (const FVector2D& Direction : Directions)
+	{
+		Points[0] = Center + Direction * Offset;
+		Points[1] = Center + Direction * (Offset + TickLength);
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Points, ESlateDrawEffect::None, TickColor, true, TickThickness);
+	}
+
+	return LayerId;
+}
+
+FVector2D SShooterCrosshair::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// room for the ticks at the widest spread the tuning allows, so the layout never changes while firing
+	const float MaxSpreadMultiplier{ FCrosshairSpread::GetMaxMultiplier(UShooterTuningSettings::GetTuning()) };
+	const float HalfSize{ BaseSpread + SpreadScale * MaxSpreadMultiplier + TickLength };
+	return FVector2D(HalfSize * 2.f, HalfSize * 2.f);
+}
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+/**
+ * Crosshair drawn as four ticks pushed outwards by the spread multiplier.
+ * Only repaints when the spread is changed through SetSpreadMultiplier.
+ */
+class SHOOTER_API SShooterCrosshair : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SShooterCrosshair)
+		: _BaseSpread(8.f)
+		, _SpreadScale(16.f)
+		, _TickLength(10.f)
+		, _TickThickness(2.f)
+		, _Color(FLinearColor::White)
+	{}
+		// distance of each tick from the center at zero spread, in slate units
+		SLATE_ARGUMENT(float, BaseSpread)
+		// extra distance per unit of spread multiplier
+		SLATE_ARGUMENT(float, SpreadScale)
+		SLATE_ARGUMENT(float, TickLength)
+		SLATE_ARGUMENT(float, TickThickness)
+		SLATE_ARGUMENT(FLinearColor, Color)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	// invalidates paint only if the spread actually changed
+	void SetSpreadMultiplier(float InSpreadMultiplier);
+
+	// SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	float BaseSpread;
+	float SpreadScale;
+	float TickLength;
+	float TickThickness;
+	FLinearColor Color;
+
+	float SpreadMultiplier;
+};
@@ -2,5 +2,65 @@
 
 #include "Shooter.h"
 #include "Modules/ModuleManager.h"
+#include "Engine/World.h"
+#include "Containers/Ticker.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Shooter, "Shooter" );
+DEFINE_LOG_CATEGORY(LogShooter);
+
+DEFINE_STAT(STAT_ShooterComponentUpdatesAvoided);
+
+#if STATS
+namespace
+{
+	// updates avoided since the stat was last published
+	uint32 ComponentUpdatesAvoidedThisSecond = 0;
+
+	bool PublishComponentUpdatesAvoided(float DeltaTime)
+	{
+		SET_DWORD_STAT(STAT_ShooterComponentUpdatesAvoided, ComponentUpdatesAvoidedThisSecond);
+		ComponentUpdatesAvoidedThisSecond = 0;
+		return true;
+	}
+}
+
+void ShooterCountComponentUpdatesAvoided(uint32 Count)
+{
+	ComponentUpdatesAvoidedThisSecond += Count;
+}
+#endif
+
+class FShooterModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if STATS
+		// the core ticker runs once a frame in every world type, so this rolls the window even when nothing is being skipped
+		ComponentUpdatesAvoidedTicker = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&PublishComponentUpdatesAvoided), 1.f);
+#endif
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FTicker::GetCoreTicker().RemoveTicker(ComponentUpdatesAvoidedTicker);
+	}
+
+private:
+	FDelegateHandle ComponentUpdatesAvoidedTicker;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FShooterModule, Shooter, "Shooter" );
+
+#if !UE_SERVER
+static TAutoConsoleVariable<int32> CVarServerRunCosmetics(
+	TEXT("shooter.Server.RunCosmetics"),
+	0,
+	TEXT("1 runs camera, FX, audio and UI work on dedicated servers, for comparing server tick cost with 'stat Shooter'."));
+
+bool ShooterShouldRunCosmetics(const UWorld* World)
+{
+	if (World == nullptr || World->GetNetMode() != NM_DedicatedServer) return true;
+
+	return CVarServerRunCosmetics.GetValueOnGameThread() != 0;
+}
+#endif
@@ -4,3 +4,30 @@
 
 #include "CoreMinimal.h"
 
+SHOOTER_API DECLARE_LOG_CATEGORY_EXTERN(LogShooter, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("Shooter"), STATGROUP_Shooter, STATCAT_Advanced);
+
+// component updates skipped because an interpolation had already converged, summed over the last second
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Component Updates Avoided/s"), STAT_ShooterComponentUpdatesAvoided, STATGROUP_Shooter, SHOOTER_API);
+
+// counts toward STAT_ShooterComponentUpdatesAvoided, which the module publishes once a second
+#if STATS
+SHOOTER_API void ShooterCountComponentUpdatesAvoided(uint32 Count);
+#else
+FORCEINLINE void ShooterCountComponentUpdatesAvoided(uint32 Count) {}
+#endif
+
+// trace channel that only the per-bone hitboxes respond to
+#define ECC_Hitbox ECollisionChannel::ECC_GameTraceChannel1
+
+class UWorld;
+
+// false where nothing is seen or heard, so camera, FX, audio and UI work can be skipped.
+// Server builds compile the cosmetic branches out; other builds check for a dedicated server at runtime,
+// where shooter.Server.RunCosmetics=1 turns them back on to compare the tick cost
+#if UE_SERVER
+FORCEINLINE bool ShooterShouldRunCosmetics(const UWorld* World) { return false; }
+#else
+SHOOTER_API bool ShooterShouldRunCosmetics(const UWorld* World);
+#endif
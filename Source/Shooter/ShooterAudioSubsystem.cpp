@@ -0,0 +1,259 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterAudioSubsystem.h"
+#include "Shooter.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "Sound/SoundAttenuation.h"
+#include "GameFramework/WorldSettings.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Voices"), STAT_ShooterActiveVoices, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Sound Events"), STAT_ShooterCulledSoundEvents, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Coalesced Shots"), STAT_ShooterCoalescedShots, STATGROUP_Shooter);
+
+namespace
+{
+	// voices in the pool, shared by every category
+	constexpr int32 MaxVoices = 24;
+
+	// voices each weapon type may hold at once, indexed by EWeaponType
+	constexpr int32 MaxVoicesPerWeaponType[] =
+	{
+		// SubmachineGun
+		6,
+		// AssaultRifle
+		6,
+		// Shotgun
+		4,
+	};
+	static_assert(UE_ARRAY_COUNT(MaxVoicesPerWeaponType) == static_cast<int32>(EWeaponType::EWT_MAX), "MaxVoicesPerWeaponType needs an entry per EWeaponType");
+
+	// category for sounds that aren't gunfire
+	constexpr uint8 ItemCategory = static_cast<uint8>(EWeaponType::EWT_MAX);
+	constexpr int32 MaxItemVoices = 4;
+
+	constexpr float LoopFadeOutTime = 0.05f;
+
+	// for sounds with no attenuation asset of their own; without it a pooled voice plays 2D at any distance
+	constexpr float DefaultAttenuationRadius = 400.f;
+	constexpr float DefaultAttenuationFalloff = 3'600.f;
+
+	FORCEINLINE uint8 WeaponTypeCategory(EWeaponType WeaponType)
+	{
+		return static_cast<uint8>(FMath::Clamp(static_cast<int32>(WeaponType), 0, static_cast<int32>(EWeaponType::EWT_MAX) - 1));
+	}
+}
+
+bool UShooterAudioSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_SERVER
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void UShooterAudioSubsystem::Deinitialize()
+{
+	for (UAudioComponent* Voice : Voices)
+	{
+		if (Voice)
+		{
+			Voice->DestroyComponent();
+		}
+	}
+	Voices.Empty();
+	VoiceCategories.Empty();
+	Emitters.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterAudioSubsystem::PlayGunfire(AActor* Shooter, EWeaponType WeaponType, float FireInterval, const FVector& Location, USoundBase* ShotSound, USoundBase* LoopSound, USoundBase* TailSound)
+{
+	if (Shooter == nullptr || ShotSound == nullptr) return;
+	if (!ShooterShouldRunCosmetics(GetWorld())) return;
+
+	const uint8 Category{ WeaponTypeCategory(WeaponType) };
+	const float Now{ GetWorld()->GetTimeSeconds() };
+
+	FGunfireEmitter* Emitter = Emitters.FindByPredicate([Shooter](const FGunfireEmitter& Candidate) { return Candidate.Shooter.Get() == Shooter; });
+	if (LoopSound && Emitter && Now - Emitter->LastShotTime <= Emitter->CoalesceWindow)
+	{
+		// still firing; the loop carries this shot
+		Emitter->LastShotTime = Now;
+		if (!Emitter->LoopVoice.IsValid() || !Emitter->LoopVoice->IsPlaying())
+		{
+			Emitter->LoopVoice = PlayVoice(Category, LoopSound, Location);
+		}
+		INC_DWORD_STAT(STAT_ShooterCoalescedShots);
+		return;
+	}
+
+	PlayVoice(Category, ShotSound, Location);
+
+	if (LoopSound)
+	{
+		if (Emitter == nullptr)
+		{
+			Emitter = &Emitters.AddDefaulted_GetRef();
+			Emitter->Shooter = Shooter;
+		}
+		Emitter->TailSound = TailSound;
+		Emitter->WeaponType = WeaponType;
+		Emitter->LastShotTime = Now;
+		Emitter->CoalesceWindow = FireInterval * 1.5f;
+	}
+}
+
+void UShooterAudioSubsystem::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location)
+{
+	if (Sound == nullptr) return;
+	if (!ShooterShouldRunCosmetics(GetWorld())) return;
+
+	PlayVoice(ItemCategory, Sound, Location);
+}
+
+void UShooterAudioSubsystem::Tick(float DeltaTime)
+{
+	const float Now{ GetWorld()->GetTimeSeconds() };
+
+	for (int32 i = Emitters.Num() - 1; i >= 0; i--)
+	{
+		FGunfireEmitter& Emitter = Emitters[i];
+		const AActor* Shooter = Emitter.Shooter.Get();
+		const bool bLooping{ Emitter.LoopVoice.IsValid() && Emitter.LoopVoice->IsPlaying() };
+
+		if (Shooter && Now - Emitter.LastShotTime <= Emitter.CoalesceWindow)
+		{
+			// the loop follows the shooter while they keep firing
+			if (bLooping)
+			{
+				Emitter.LoopVoice->SetWorldLocation(Shooter->GetActorLocation());
+			}
+			continue;
+		}
+
+		if (bLooping)
+		{
+			EndLoop(Emitter, Shooter ? Shooter->GetActorLocation() : Emitter.LoopVoice->GetComponentLocation());
+		}
+		Emitters.RemoveAtSwap(i);
+	}
+
+	UpdateVoiceStats();
+}
+
+ETickableTickType UShooterAudioSubsystem::GetTickableTickType() const
+{
+	// the class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UShooterAudioSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterAudioSubsystem, STATGROUP_Tickables);
+}
+
+UAudioComponent* UShooterAudioSubsystem::AcquireVoice(uint8 Category)
+{
+	const int32 CategoryLimit{ Category == ItemCategory ? MaxItemVoices : MaxVoicesPerWeaponType[Category] };
+
+	int32 FreeIndex{ INDEX_NONE };
+	int32 CategoryVoices{ 0 };
+	for (int32 i = 0; i < Voices.Num(); i++)
+	{
+		if (Voices[i] && Voices[i]->IsPlaying())
+		{
+			if (VoiceCategories[i] == Category)
+			{
+				++CategoryVoices;
+			}
+		}
+		else if (FreeIndex == INDEX_NONE)
+		{
+			FreeIndex = i;
+		}
+	}
+
+	if (CategoryVoices >= CategoryLimit)
+	{
+		return nullptr;
+	}
+
+	if (FreeIndex == INDEX_NONE)
+	{
+		if (Voices.Num() >= MaxVoices)
+		{
+			return nullptr;
+		}
+		FreeIndex = Voices.Add(nullptr);
+		VoiceCategories.Add(Category);
+	}
+
+	if (Voices[FreeIndex] == nullptr)
+	{
+		// pooled voices live on the world settings so they're torn down with the level
+		UAudioComponent* Voice = NewObject<UAudioComponent>(GetWorld()->GetWorldSettings());
+		Voice->bAutoActivate = false;
+		Voice->bAutoDestroy = false;
+		Voice->bAllowSpatialization = true;
+		Voice->AttenuationOverrides.bAttenuate = true;
+		Voice->AttenuationOverrides.bSpatialize = true;
+		Voice->AttenuationOverrides.AttenuationShape = EAttenuationShape::Sphere;
+		Voice->AttenuationOverrides.AttenuationShapeExtents = FVector(DefaultAttenuationRadius, 0.f, 0.f);
+		Voice->AttenuationOverrides.FalloffDistance = DefaultAttenuationFalloff;
+		Voice->RegisterComponentWithWorld(GetWorld());
+		Voices[FreeIndex] = Voice;
+	}
+
+	VoiceCategories[FreeIndex] = Category;
+	return Voices[FreeIndex];
+}
+
+UAudioComponent* UShooterAudioSubsystem::PlayVoice(uint8 Category, USoundBase* Sound, const FVector& Location)
+{
+	UAudioComponent* Voice = AcquireVoice(Category);
+	if (Voice == nullptr)
+	{
+		INC_DWORD_STAT(STAT_ShooterCulledSoundEvents);
+		return nullptr;
+	}
+
+	Voice->SetWorldLocation(Location);
+	Voice->SetSound(Sound);
+
+	// the sound's own attenuation wins; the default only stands in when it has none
+	Voice->bOverrideAttenuation = Sound->AttenuationSettings == nullptr;
+	Voice->Play();
+
+	UpdateVoiceStats();
+	return Voice;
+}
+
+void UShooterAudioSubsystem::EndLoop(FGunfireEmitter& Emitter, const FVector& Location)
+{
+	Emitter.LoopVoice->FadeOut(LoopFadeOutTime, 0.f);
+	Emitter.LoopVoice.Reset();
+
+	if (USoundBase* TailSound = Emitter.TailSound.Get())
+	{
+		PlayVoice(WeaponTypeCategory(Emitter.WeaponType), TailSound, Location);
+	}
+}
+
+void UShooterAudioSubsystem::UpdateVoiceStats() const
+{
+#if STATS
+	int32 ActiveVoices{ 0 };
+	for (const UAudioComponent* Voice : Voices)
+	{
+		if (Voice && Voice->IsPlaying())
+		{
+			++ActiveVoices;
+		}
+	}
+	SET_DWORD_STAT(STAT_ShooterActiveVoices, ActiveVoices);
+#endif
+}
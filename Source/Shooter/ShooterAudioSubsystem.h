@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WeaponType.h"
+#include "ShooterAudioSubsystem.generated.h"
+
+// a shooter currently holding a full auto loop
+struct FGunfireEmitter
+{
+	TWeakObjectPtr<AActor> Shooter;
+	TWeakObjectPtr<class UAudioComponent> LoopVoice;
+	TWeakObjectPtr<class USoundBase> TailSound;
+	EWeaponType WeaponType = EWeaponType::EWT_SubmachineGun;
+	float LastShotTime = 0.f;
+	float CoalesceWindow = 0.f;
+};
+
+/**
+ * Plays gunfire and item sounds as spatialized voices from a fixed pool of audio components.
+ * Rapid full auto shots from one shooter are coalesced into a looping sound that ends with a tail,
+ * and every weapon type has a cap on how many voices it may hold at once
+ */
+UCLASS()
+class SHOOTER_API UShooterAudioSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	// never created in server builds
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	// plays one shot from Shooter; with a LoopSound, shots closer together than 1.5 fire intervals hold the loop instead
+	void PlayGunfire(AActor* Shooter, EWeaponType WeaponType, float FireInterval, const FVector& Location, USoundBase* ShotSound, USoundBase* LoopSound, USoundBase* TailSound);
+
+	// plays a non gunfire sound at Location, e.g. pickups
+	void PlaySoundAtLocation(USoundBase* Sound, const FVector& Location);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return Emitters.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	// an idle voice from the pool, or nullptr when the pool or the category's cap is full
+	UAudioComponent* AcquireVoice(uint8 Category);
+
+	UAudioComponent* PlayVoice(uint8 Category, USoundBase* Sound, const FVector& Location);
+
+	// stops Emitter's loop and plays its tail
+	void EndLoop(FGunfireEmitter& Emitter, const FVector& Location);
+
+	void UpdateVoiceStats() const;
+
+	UPROPERTY()
+	TArray<UAudioComponent*> Voices;
+
+	// the EWeaponType of each voice's last sound, or ItemCategory
+	TArray<uint8> VoiceCategories;
+
+	TArray<FGunfireEmitter> Emitters;
+};
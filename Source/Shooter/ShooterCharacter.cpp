@@ -2,6 +2,7 @@
 
 
 #include "ShooterCharacter.h"
+#include "Shooter.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -11,66 +12,44 @@
 #include "DrawDebugHelpers.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Item.h"
-#include "Components/WidgetComponent.h"
+#include "ShooterPlayerController.h"
+#include "PickupPoolSubsystem.h"
+#include "ShooterDamageSubsystem.h"
+#include "ShooterAudioSubsystem.h"
+#include "ShooterHitboxComponent.h"
+#include "HitboxSubsystem.h"
 #include "Weapon.h"
+#include "ShooterMovementComponent.h"
+#include "ShooterTuningSettings.h"
+#include "ShooterTelemetry.h"
 #include "Components/SphereComponent.h"
 #include "Components/BoxComponent.h"
 #include "Components/CapsuleComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Character Tick"), STAT_ShooterCharacterTick, STATGROUP_Shooter);
+
 // Sets default values
-AShooterCharacter::AShooterCharacter() :
-	//base rates for turning/looking up
-	BaseTurnRate(45.f),
-	BaseLookUpRate(45.f),
-	// turn rates for aiming/ not aiming
-	HipTurnRate(90.f),
-	HipLookUpRate(90.f),
-	AimingTurnRate(20.f),
-	AimingLookUpRate(20.f),
-	// mouse look sensitivity scale factors
-	MouseHipTurnRate(1.0f),
-	MouseHipLookUpRate(1.0f),
-	MouseAimingTurnRate(0.2f),
-	MouseAimingLookUpRate(0.2f),
-	//true when aiming the weapon
+AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer) :
+	Super(ObjectInitializer.SetDefaultSubobjectClass<UShooterMovementComponent>(ACharacter::CharacterMovementComponentName)),
+	//Blueprint copies of the hot state
 	bAiming(false),
-	//camera feild of view values
-	CameraDefaultFOV(0.f), //set in BeginPlay
-	CameraZoomedFOV(35.f),
-	CameraCurrentFOV(0.f),
-	ZoomInterpSpeed(20.f),
-	//crosshair aim factors
 	CrosshairSpreadMultiplier(0.f),
-	CrosshairVelocityFactor(0.f),
-	CrosshairInAirFactor(0.f),
-	CrosshairAimFactor(0.f),
-	CrosshairShootingFactor(0.f),
+	CombatState(ECombatState::ECS_Unoccupied),
+	ImpactClusterRadius(30.f),
+	CrosshairSpreadBroadcastThreshold(0.01f),
 	//Bullet fire timer variables
 	ShootTimeDuration(0.05f),
-	bFiringBullet(false),
-	//Automatic Gun Fire variables
-	AutomaticFireRate(0.1f),
-	bShouldFire(true),
-	bFireButtonPressed(false),
-	//Item traced variables
-	bShouldTraceForItems(false),
-	OverlappedItemCount(0),
 	//Camera interp location variables
 	CameraInterpDistance(250.f),
 	CameraInterpElevation(65.f),
 	//Starting Ammo amounts
 	Starting9mmAmmo(85),
 	StartingARAmmo(123),
+	StartingShellAmmo(24),
 	//Combat Variables
-	CombatState(ECombatState::ECS_Unoccupied),
-	bCrouching(false),
-	BaseMovementSpeed(650.f),
-	CrouchMovementSpeed(350.f),
-	StandingCapsuleHalfHeight(88.f),
-	CrouchingCapsuleHalfHeight(44.f),
-	BaseGroundFriction(2.f),
-	CrouchingGroundFriction(100.f)
-	//SprintSpeed(1200.f)
+	Health(100.f),
+	MaxHealth(100.f),
+	bDying(false)
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -92,13 +71,21 @@ AShooterCharacter::AShooterCharacter() :
 	bUseControllerRotationRoll = false;
 
 	// configure character movement 
+	ShooterMovement = CastChecked<UShooterMovementComponent>(GetCharacterMovement());
 	GetCharacterMovement()->bOrientRotationToMovement = false; // character moves in the direction of input...
 	GetCharacterMovement()->RotationRate = FRotator(0.f, 540.f, 0.f); // at this rotation rate
 	GetCharacterMovement()->JumpZVelocity = 600.f;
 	GetCharacterMovement()->AirControl = 0.2f;
 
-	//create handscene component
+	//create handscene component, attached to the left hand once instead of every reload
 	HandSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("HandSceneComp"));
+	HandSceneComponent->SetupAttachment(GetMesh(), FName(TEXT("Hand_L")));
+
+	// bullets hit the hitbox capsules instead of the capsule or the physics asset,
+	// so the mesh doesn't need its bodies updated every frame
+	HitboxComponent = CreateDefaultSubobject<UShooterHitboxComponent>(TEXT("HitboxComponent"));
+	GetMesh()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Ignore);
 
 }
 
@@ -109,15 +96,19 @@ void AShooterCharacter::BeginPlay()
 
 	if (FollowCamera)
 	{
-		CameraDefaultFOV = GetFollowCamera()->FieldOfView;
-		CameraCurrentFOV = CameraDefaultFOV;
+		HotState.CameraDefaultFOV = GetFollowCamera()->FieldOfView;
+		HotState.CameraCurrentFOV = HotState.CameraDefaultFOV;
+		HotState.CameraTargetFOV = HotState.CameraDefaultFOV;
 	}
 
 	// spawn default weapon and equipt it
 	EquipWeapon(SpawnDefaultWeapon());
 
 	InitializeAmmoMap();
-	GetCharacterMovement()->MaxWalkSpeed = BaseMovementSpeed;
+
+	Health = MaxHealth;
+
+	ShotRandom = FShotRandom(GetTypeHash(GetFName()) ^ FPlatformTime::Cycles());
 }
 
 void AShooterCharacter::MoveForward(float Value)
@@ -149,224 +140,228 @@ void AShooterCharacter::MoveRight(float Value)
 void AShooterCharacter::TurnAtRate(float Rate)
 {
 	//  calculate delta for this frame from the rate info
-	AddControllerYawInput(Rate * BaseTurnRate * GetWorld()->GetDeltaSeconds()); // deg/sec * sec/frame
+	const FShooterTuning& Tuning = UShooterTuningSettings::GetTuning();
+	const float TurnRate{ HotState.bAiming ? Tuning.AimingTurnRate : Tuning.HipTurnRate };
+	AddControllerYawInput(Rate * TurnRate * GetWorld()->GetDeltaSeconds()); // deg/sec * sec/frame
 }
 
 void AShooterCharacter::LookUpAtRate(float Rate)
 {
-	AddControllerPitchInput(Rate * BaseLookUpRate * GetWorld()->GetDeltaSeconds()); // deg/sec * sec/frame
+	const FShooterTuning& Tuning = UShooterTuningSettings::GetTuning();
+	const float LookUpRate{ HotState.bAiming ? Tuning.AimingLookUpRate : Tuning.HipLookUpRate };
+	AddControllerPitchInput(Rate * LookUpRate * GetWorld()->GetDeltaSeconds()); // deg/sec * sec/frame
 }
 
 void AShooterCharacter::Turn(float Value)
 {
-	float TurnScaleFactor{};
-	if (bAiming)
-	{
-		TurnScaleFactor = MouseAimingTurnRate;
-	}
-	else
-	{
-		TurnScaleFactor = MouseHipTurnRate;
-	}
+	const FShooterTuning& Tuning = UShooterTuningSettings::GetTuning();
+	const float TurnScaleFactor{ HotState.bAiming ? Tuning.MouseAimingTurnRate : Tuning.MouseHipTurnRate };
 	AddControllerYawInput(Value * TurnScaleFactor);
 }
 
 void AShooterCharacter::LookUp(float Value)
 {
-	float LookUpScaleFactor{};
-	if (bAiming)
-	{
-		LookUpScaleFactor = MouseAimingLookUpRate;
-	}
-	else
-	{
-		LookUpScaleFactor = MouseHipLookUpRate;
-	}
+	const FShooterTuning& Tuning = UShooterTuningSettings::GetTuning();
+	const float LookUpScaleFactor{ HotState.bAiming ? Tuning.MouseAimingLookUpRate : Tuning.MouseHipLookUpRate };
 	AddControllerPitchInput(Value * LookUpScaleFactor);
 }
 
-void AShooterCharacter::FireWeapon()
+void AShooterCharacter::FireWeapon(TArrayView<const float> ShotAges)
 {
 	if (EquippedWeapon == nullptr) return;
-	if (CombatState != ECombatState::ECS_Unoccupied) return;
 
-	if (WeaponHasAmmo())
+	// sound, muzzle flash and montage play once per batch; every shot still traces, kicks and uses ammo
+	PlayFireSound();
+	SendBullets(ShotAges);
+	for (int32 Shot = 0; Shot < ShotAges.Num(); Shot++)
 	{
-		PlayFireSound();
-		SendBullet();
-		PlayGunfireMontage();
+		ApplyRecoil();
 		EquippedWeapon->DecrementAmmo();
-
-		StartFireTimer();
 	}
+	PlayGunfireMontage();
+	PushHUDAmmo();
+
+	FShooterTelemetry::Record(EShooterTelemetryEventType::ShotFired, GetUniqueID(), GetActorLocation(), static_cast<uint8>(EquippedWeapon->GetWeaponType()), static_cast<uint16>(ShotAges.Num()));
+
 	//start bullet fire timer for crosshairs
 	StartCrosshairBulletFire();
 }
 
-bool AShooterCharacter::GetBeamEndLocation(const FVector& MuzzleSocketLocation, FVector& OutBeamLocation)
+void AShooterCharacter::UpdateFire(float DeltaTime)
+{
+	if (EquippedWeapon == nullptr) return;
+	if (HotState.CombatState == ECombatState::ECS_Reloading) return;
+
+	FFireScheduler::FShotAges ShotAges;
+	HotState.FireScheduler.Advance(DeltaTime, EquippedWeapon->GetFireInterval(), EquippedWeapon->GetAmmo(), ShotAges);
+	if (ShotAges.Num() > 0)
+	{
+		FireWeapon(ShotAges);
+	}
+
+	if (!WeaponHasAmmo())
+	{
+		HotState.FireScheduler.CancelShots();
+	}
+
+	if (HotState.FireScheduler.IsBusy())
+	{
+		if (HotState.CombatState != ECombatState::ECS_FireTimerInProgress)
+		{
+			SetCombatState(ECombatState::ECS_FireTimerInProgress);
+		}
+	}
+	else if (HotState.CombatState == ECombatState::ECS_FireTimerInProgress)
+	{
+		SetCombatState(ECombatState::ECS_Unoccupied);
+
+		if (!WeaponHasAmmo())
+		{
+			ReloadWeapon();
+		}
+	}
+}
+
+void AShooterCharacter::GetAimLocation(FVector& OutAimLocation)
 {
 	// check for crosshair trace hit 
 	FHitResult CrosshairHitResult;
-	bool bCrosshairHit = TraceUnderCrosshairs(CrosshairHitResult, OutBeamLocation);
+	bool bCrosshairHit = TraceUnderCrosshairs(CrosshairHitResult, OutAimLocation);
 
 	if (bCrosshairHit)
 	{
 		// Tentative beam Location - still need to trace from gun
-		OutBeamLocation = CrosshairHitResult.Location;
+		OutAimLocation = CrosshairHitResult.Location;
 	}
 	else // no crosshair tracehit
 	{
-		// outbeam location is the end location for the line trace 
+		// OutAimLocation is the end location for the line trace 
 	}
-
-	// preform second trace, this time from the gun barrel
-	FHitResult WeaponTraceHit;
-	const FVector WeaponTraceStart{ MuzzleSocketLocation };
-	const FVector StartToEnd{ OutBeamLocation - MuzzleSocketLocation };
-	const FVector WeaponTraceEnd{ MuzzleSocketLocation + StartToEnd * 1.25f };
-	
-	GetWorld()->LineTraceSingleByChannel(WeaponTraceHit, WeaponTraceStart, WeaponTraceEnd, ECollisionChannel::ECC_Visibility);
-	
-	if (WeaponTraceHit.bBlockingHit) //object between barrel and BeamEndPoints?
-	{
-		OutBeamLocation = WeaponTraceHit.Location;
-		return true;
-	}
-
-	return false;
 }
 
+void AShooterCharacter::TraceShots(TArrayView<const FVector> ShotStarts, TArrayView<const FVector> ShotDirections, float TraceDistance, TArrayView<FHitResult> OutHitResults)
+{
+	check(ShotStarts.Num() == ShotDirections.Num() && ShotDirections.Num() == OutHitResults.Num());
+	const int32 NumShots = ShotDirections.Num();
 
+	// don't shoot ourselves
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(this);
 
+	// world traces for the whole batch first
+	TArray<FVector, TInlineAllocator<16>> TraceEnds;
+	TraceEnds.SetNumUninitialized(NumShots);
+	for (int32 i = 0; i < NumShots; i++)
+	{
+		const FVector WeaponTraceEnd{ ShotStarts[i] + ShotDirections[i] * TraceDistance };
+		GetWorld()->LineTraceSingleByChannel(OutHitResults[i], ShotStarts[i], WeaponTraceEnd, ECollisionChannel::ECC_Visibility, QueryParams);
 
-	
+		// characters only respond to the hitbox channel; trace them up to whatever the world trace hit
+		TraceEnds[i] = OutHitResults[i].bBlockingHit ? OutHitResults[i].Location : WeaponTraceEnd;
+	}
+
+	// then one hitbox pass, which prepares nearby hitboxes once for every pellet
+	UHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UHitboxSubsystem>();
+	if (HitboxSubsystem)
+	{
+		HitboxSubsystem->TraceHitboxesBatch(ShotStarts, TraceEnds, OutHitResults, this);
+	}
+}
 
 void AShooterCharacter::AimingButtonPressed()
 {
-	bAiming = true;
-	
+	HotState.bAiming = true;
+	if (AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(GetController()))
+	{
+		ShooterController->SetHUDAiming(HotState.bAiming);
+	}
 }
 
 void AShooterCharacter::AimingButtonReleased()
 {
-	bAiming = false;
-	
+	HotState.bAiming = false;
+	if (AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(GetController()))
+	{
+		ShooterController->SetHUDAiming(HotState.bAiming);
+	}
 }
 
 void AShooterCharacter::CameraInterpZoom(float DeltaTime)
 {
-	//set current camera field of view
-	if (bAiming)
-	{
-		//interp to zoomed FOV
-		CameraCurrentFOV = FMath::FInterpTo(CameraCurrentFOV, CameraZoomedFOV, DeltaTime, ZoomInterpSpeed);
+	const FShooterTuning& Tuning = UShooterTuningSettings::GetTuning();
 
-	}
-	else
+	// interp to the zoomed FOV while aiming, back to the default FOV otherwise
+	const float TargetFOV{ HotState.bAiming ? Tuning.CameraZoomedFOV : HotState.CameraDefaultFOV };
+	if (TargetFOV != HotState.CameraTargetFOV)
 	{
-		// interp to default FOV
-		CameraCurrentFOV = FMath::FInterpTo(CameraCurrentFOV, CameraDefaultFOV, DeltaTime, ZoomInterpSpeed);
-
+		HotState.CameraTargetFOV = TargetFOV;
+		HotState.bZoomInFlight = true;
 	}
-	GetFollowCamera()->SetFieldOfView(CameraCurrentFOV);
-}
 
-void AShooterCharacter::SetLookRates()
-{
-	if (bAiming)
+	// once converged the camera is left alone until aiming changes
+	if (!HotState.bZoomInFlight)
 	{
-		BaseTurnRate = AimingTurnRate;
-		BaseLookUpRate = AimingLookUpRate;
+		ShooterCountComponentUpdatesAvoided(1);
+		return;
 	}
-	else
+
+	HotState.CameraCurrentFOV = FMath::FInterpTo(HotState.CameraCurrentFOV, HotState.CameraTargetFOV, DeltaTime, Tuning.ZoomInterpSpeed);
+	if (FMath::IsNearlyEqual(HotState.CameraCurrentFOV, HotState.CameraTargetFOV, 0.01f))
 	{
-		BaseTurnRate = HipTurnRate;
-		BaseLookUpRate = HipLookUpRate;
+		HotState.CameraCurrentFOV = HotState.CameraTargetFOV;
+		HotState.bZoomInFlight = false;
 	}
-
+	GetFollowCamera()->SetFieldOfView(HotState.CameraCurrentFOV);
 }
 
 void AShooterCharacter::CalculateCrosshairSpread(float DeltaTime)
 {
-	FVector2D WalkSpeedRange{ 0.f, 600.f};
-	FVector2D VelocityMultiplierRange{ 0.f, 1.f };
 	FVector Velocity{ GetVelocity() };
 	Velocity.Z = 0.f;
 
-	// calculate crosshair velocity factor
-	CrosshairVelocityFactor = FMath::GetMappedRangeValueClamped(WalkSpeedRange, VelocityMultiplierRange, Velocity.Size());
+	HotState.CrosshairSpread.Update(UShooterTuningSettings::GetTuning(), DeltaTime, Velocity.Size(), GetCharacterMovement()->IsFalling(), HotState.bAiming, HotState.bFiringBullet);
+	HotState.CrosshairSpreadMultiplier = HotState.CrosshairSpread.GetMultiplier();
 
-	// calculate crosshair in air factor
-	if (GetCharacterMovement()->IsFalling()) // is in air?
-	{
-		CrosshairInAirFactor = FMath::FInterpTo(CrosshairInAirFactor, 2.25f, DeltaTime, 2.25f);
-	}
-	else // character is on the ground
+	// only push to the HUD when the change is visible
+	if (ShooterShouldRunCosmetics(GetWorld()) && FMath::Abs(HotState.CrosshairSpreadMultiplier - HotState.BroadcastCrosshairSpreadMultiplier) > CrosshairSpreadBroadcastThreshold)
 	{
-		// shrink the cross hairs rapidly on the ground
-		CrosshairInAirFactor = FMath::FInterpTo(CrosshairInAirFactor, 0.f, DeltaTime, 30.f);
+		HotState.BroadcastCrosshairSpreadMultiplier = HotState.CrosshairSpreadMultiplier;
+		if (AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(GetController()))
+		{
+			ShooterController->SetHUDCrosshairSpread(HotState.CrosshairSpreadMultiplier);
+		}
 	}
+}
 
-	// calculate crosshair aim factor
-	if (bAiming) // are we aiming?
-	{
-		// shrink crosshairs a small amount very quickly
-		CrosshairAimFactor = FMath::FInterpTo(CrosshairAimFactor, 0.6f, DeltaTime, 30.f);
-	}
-	else // not aiming
-	{
-		// spread crosshairs back to normal very quickly
-		CrosshairAimFactor = FMath::FInterpTo(CrosshairAimFactor, 0.0f, DeltaTime, 30.f);
-	}
+void AShooterCharacter::FireButtonPressed()
+{
+	HotState.bFireButtonPressed = true;
 
-	//true 0.05 second after firing
-	if (bFiringBullet)
-	{
-		CrosshairShootingFactor = FMath::FInterpTo(CrosshairShootingFactor, 0.3f, DeltaTime, 60.f);
-	}
-	else
+	// a press during a reload is dropped rather than armed, or the shots would fire the moment the reload finishes
+	if (EquippedWeapon && HotState.CombatState != ECombatState::ECS_Reloading)
 	{
-		CrosshairShootingFactor = FMath::FInterpTo(CrosshairShootingFactor, 0.f, DeltaTime, 60.f);
+		HotState.FireScheduler.PressTrigger(EquippedWeapon->GetFireMode(), EquippedWeapon->GetBurstCount());
 	}
 
-	CrosshairSpreadMultiplier = 0.5f + CrosshairVelocityFactor + CrosshairInAirFactor - CrosshairAimFactor + CrosshairShootingFactor;
-}
-
-void AShooterCharacter::FireButtonPressed()
-{
-	bFireButtonPressed = true;
-	FireWeapon();
-	
 }
 
 void AShooterCharacter::FireButtonReleased()
 {
-	bFireButtonPressed = false;
+	HotState.bFireButtonPressed = false;
+	HotState.FireScheduler.ReleaseTrigger();
+	HotState.RecoilShotIndex = 0;
 }
 
-void AShooterCharacter::StartFireTimer()
+void AShooterCharacter::ApplyRecoil()
 {
-	CombatState = ECombatState::ECS_FireTimerInProgress;
-	GetWorldTimerManager().SetTimer(AutoFireTimer, this, &AShooterCharacter::AutoFireReset, AutomaticFireRate);
-	
-}
+	if (Controller == nullptr || EquippedWeapon == nullptr) return;
 
-void AShooterCharacter::AutoFireReset()
-{
-	CombatState = ECombatState::ECS_Unoccupied;
+	const FVector2D Kick{ FShotSpread::GetRecoilKick(EquippedWeapon->GetWeaponType(), HotState.RecoilShotIndex++) };
 
-	if (WeaponHasAmmo())
-	{
-		if (bFireButtonPressed)
-		{
-			FireWeapon();
-		}
-	}
-	else
-	{
-		ReloadWeapon();
-	}
-	
+	FRotator ControlRotation{ Controller->GetControlRotation() };
+	ControlRotation.Pitch += Kick.X;
+	ControlRotation.Yaw += Kick.Y;
+	Controller->SetControlRotation(ControlRotation);
 }
 
 bool AShooterCharacter::TraceUnderCrosshairs(FHitResult& OutHitResult, FVector& OutHitLocation)
@@ -386,6 +381,15 @@ bool AShooterCharacter::TraceUnderCrosshairs(FHitResult& OutHitResult, FVector&
 	//Get world position and direction of crosshairs
 	bool bScreenToWorld = UGameplayStatics::DeprojectScreenToWorld(UGameplayStatics::GetPlayerController(this, 0), CrosshairLocation, CrosshairWorldPosition, CrosshairWorldDirection);
 
+	// no viewport on a dedicated server; the crosshairs sit at the center of the controller's view
+	if (!bScreenToWorld && GetController())
+	{
+		FRotator ViewRotation;
+		GetController()->GetPlayerViewPoint(CrosshairWorldPosition, ViewRotation);
+		CrosshairWorldDirection = ViewRotation.Vector();
+		bScreenToWorld = true;
+	}
+
 	if (bScreenToWorld)
 	{
 		//trace from crosshair world location outward
@@ -393,6 +397,16 @@ bool AShooterCharacter::TraceUnderCrosshairs(FHitResult& OutHitResult, FVector&
 		const FVector End{ Start + CrosshairWorldDirection * 50'000.f };
 		OutHitLocation = End;
 		GetWorld()->LineTraceSingleByChannel(OutHitResult, Start, End, ECollisionChannel::ECC_Visibility);
+
+		// characters ignore visibility, so aim at their hitboxes up to whatever the world trace hit
+		if (UHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UHitboxSubsystem>())
+		{
+			FHitResult HitboxHitResult;
+			if (HitboxSubsystem->TraceHitboxes(HitboxHitResult, Start, OutHitResult.bBlockingHit ? OutHitResult.Location : End, this))
+			{
+				OutHitResult = HitboxHitResult;
+			}
+		}
 		
 		if (OutHitResult.bBlockingHit)
 		{
@@ -406,7 +420,7 @@ bool AShooterCharacter::TraceUnderCrosshairs(FHitResult& OutHitResult, FVector&
 
 void AShooterCharacter::StartCrosshairBulletFire()
 {
-	bFiringBullet = true;
+	HotState.bFiringBullet = true;
 	
 	//.SeTimer Error
 	GetWorldTimerManager().SetTimer(CrosshairShootTimer, this, &AShooterCharacter::FinishCrosshairBulletFire, ShootTimeDuration);
@@ -414,13 +428,16 @@ void AShooterCharacter::StartCrosshairBulletFire()
 
 void AShooterCharacter::FinishCrosshairBulletFire()
 {
-	bFiringBullet = false;
+	HotState.bFiringBullet = false;
 
 }
 
-void AShooterCharacter::TraceForItems()
+void AShooterCharacter::TraceForItems(bool bUpdatePickupWidgets)
 {
-	if (bShouldTraceForItems)
+	// TraceHitItem is gameplay state that SelectButtonPressed needs everywhere; only the widgets are cosmetic
+	AShooterPlayerController* ShooterController = bUpdatePickupWidgets ? Cast<AShooterPlayerController>(GetController()) : nullptr;
+
+	if (HotState.bShouldTraceForItems)
 	{
 		FHitResult ItemTraceResult;
 		FVector HitLocation;
@@ -428,18 +445,18 @@ void AShooterCharacter::TraceForItems()
 		if (ItemTraceResult.bBlockingHit)
 		{
 			TraceHitItem = Cast<AItem>(ItemTraceResult.Actor);
-			if (TraceHitItem && TraceHitItem->GetPickupWidget())
-			{
-				// show items pickup widget
-				TraceHitItem->GetPickupWidget()->SetVisibility(true);
-			}
 
-			// we hit an AItem last frame
-			if (TraceHitItemLastFrame)
+			// only rebind the pooled pickup widget when the focused item changes
+			if (TraceHitItem != TraceHitItemLastFrame && ShooterController)
 			{
-				if (TraceHitItem != TraceHitItemLastFrame)
+				if (TraceHitItemLastFrame)
+				{
+					ShooterController->HidePickupWidget(TraceHitItemLastFrame);
+				}
+				if (TraceHitItem)
 				{
-					TraceHitItemLastFrame->GetPickupWidget()->SetVisibility(false);
+					// show items pickup widget
+					ShooterController->ShowPickupWidget(TraceHitItem);
 				}
 			}
 
@@ -452,7 +469,11 @@ void AShooterCharacter::TraceForItems()
 	{
 		//No longer overlapping any items,
 		// Item Last frame should not show widget
-		TraceHitItemLastFrame->GetPickupWidget()->SetVisibility(false);
+		if (ShooterController)
+		{
+			ShooterController->HidePickupWidget(TraceHitItemLastFrame);
+		}
+		TraceHitItemLastFrame = nullptr;
 	}
 }
 
@@ -461,7 +482,11 @@ AWeapon* AShooterCharacter::SpawnDefaultWeapon()
 	// check the TSubclassOf variable
 	if (DefaultWeaponClass)
 	{
-		// spawn the weapon
+		// take the weapon from the pickup pool
+		if (UPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UPickupPoolSubsystem>())
+		{
+			return PickupPool->AcquireItem<AWeapon>(DefaultWeaponClass, GetActorTransform());
+		}
 		return GetWorld()->SpawnActor<AWeapon>(DefaultWeaponClass);
 	}
 
@@ -486,6 +511,15 @@ void AShooterCharacter::EquipWeapon(AWeapon* WeaponToEquip)
 		//Set EquippedWeapon to the newly spawned weapon
 		EquippedWeapon = WeaponToEquip;
 		EquippedWeapon->SetItemState(EItemState::EIS_Equipped);
+
+		// resolve the clip bone now so reloading doesn't look it up by name
+		EquippedWeapon->CacheBoneIndices();
+		EquippedWeapon->SetClipHandComponent(HandSceneComponent);
+
+		// shots armed for the previous weapon don't carry over
+		HotState.FireScheduler.CancelShots();
+
+		PushHUDAmmo();
 	}
 }
 
@@ -498,6 +532,12 @@ void AShooterCharacter::DropWeapon()
 
 		EquippedWeapon->SetItemState(EItemState::EIS_Falling);
 		EquippedWeapon->ThrowWeapon();
+
+		// dropped weapons count against the world's budget instead of piling up for the rest of the match
+		if (UPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UPickupPoolSubsystem>())
+		{
+			PickupPool->TrackDroppedItem(EquippedWeapon);
+		}
 	}
 }
 
@@ -505,11 +545,14 @@ void AShooterCharacter::SelectButtonPressed()
 {
 	if (TraceHitItem)
 	{
-		TraceHitItem->StartItemCurve(this);
+		// StartItemCurve can finish the pickup straight away and clear TraceHitItem through SwapWeapon
+		AItem* PickedItem = TraceHitItem;
+		PickedItem->StartItemCurve(this);
 
-		if (TraceHitItem->GetPickUpSound())
+		UShooterAudioSubsystem* AudioSubsystem = GetWorld()->GetSubsystem<UShooterAudioSubsystem>();
+		if (AudioSubsystem && PickedItem->GetPickUpSound())
 		{
-			UGameplayStatics::PlaySound2D(this, TraceHitItem->GetPickUpSound());
+			AudioSubsystem->PlaySoundAtLocation(PickedItem->GetPickUpSound(), GetActorLocation());
 		}
 	}
 	
@@ -523,6 +566,15 @@ void AShooterCharacter::SwapWeapon(AWeapon* WeaponToSwap)
 {
 	DropWeapon();
 	EquipWeapon(WeaponToSwap);
+
+	FShooterTelemetry::Record(EShooterTelemetryEventType::WeaponSwap, GetUniqueID(), GetActorLocation(), static_cast<uint8>(WeaponToSwap->GetWeaponType()));
+
+	// the picked up item no longer needs its pickup widget
+	AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(GetController());
+	if (ShooterController && TraceHitItemLastFrame)
+	{
+		ShooterController->HidePickupWidget(TraceHitItemLastFrame);
+	}
 	TraceHitItem = nullptr;
 	TraceHitItemLastFrame = nullptr;
 }
@@ -531,6 +583,9 @@ void AShooterCharacter::InitializeAmmoMap()
 {
 	AmmoMap.Add(EAmmoType::EAT_9mm, Starting9mmAmmo);
 	AmmoMap.Add(EAmmoType::EAT_AR, StartingARAmmo);
+	AmmoMap.Add(EAmmoType::EAT_Shells, StartingShellAmmo);
+
+	PushHUDAmmo();
 }
 
 bool AShooterCharacter::WeaponHasAmmo()
@@ -541,13 +596,16 @@ bool AShooterCharacter::WeaponHasAmmo()
 }
 void AShooterCharacter::PlayFireSound()
 {
-	//Play Fire sound
-	if (FireSound)
+	//Play Fire sound, spatialized and voice limited by the audio subsystem
+	if (!ShooterShouldRunCosmetics(GetWorld())) return;
+
+	UShooterAudioSubsystem* AudioSubsystem = GetWorld()->GetSubsystem<UShooterAudioSubsystem>();
+	if (AudioSubsystem && FireSound)
 	{
-		UGameplayStatics::PlaySound2D(this, FireSound);
+		AudioSubsystem->PlayGunfire(this, EquippedWeapon->GetWeaponType(), EquippedWeapon->GetFireInterval(), EquippedWeapon->GetActorLocation(), FireSound, FireLoopSound, FireTailSound);
 	}
 }
-void AShooterCharacter::SendBullet()
+void AShooterCharacter::SendBullets(TArrayView<const float> ShotAges)
 {
 	//Send Bullet
 	const USkeletalMeshSocket* BarrelSocket = EquippedWeapon->GetItemMesh()->GetSocketByName("BarrelSocket");
@@ -555,17 +613,72 @@ void AShooterCharacter::SendBullet()
 	if (BarrelSocket)
 	{
 		const FTransform SocketTransform = BarrelSocket->GetSocketTransform(EquippedWeapon->GetItemMesh());
+		const FVector MuzzleLocation{ SocketTransform.GetLocation() };
 
-		if (MuzzleFlash)
+		const bool bSpawnEffects{ ShooterShouldRunCosmetics(GetWorld()) };
+		if (bSpawnEffects && MuzzleFlash)
 		{
 			UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), MuzzleFlash, SocketTransform);
 		}
 
-		FVector BeamEnd;
-		bool bBeamEnd = GetBeamEndLocation(SocketTransform.GetLocation(), BeamEnd);
-		if (bBeamEnd)
+		FVector AimLocation;
+		GetAimLocation(AimLocation);
+		const FVector MuzzleToAim{ AimLocation - MuzzleLocation };
+
+		// one direction per pellet of every shot, spread inside a cone that grows with the crosshairs
+		const int32 PelletsPerShot{ FMath::Max(1, EquippedWeapon->GetPelletCount()) };
+		const int32 NumPellets{ PelletsPerShot * ShotAges.Num() };
+		const float SpreadHalfAngle{ FShotSpread::GetSpreadHalfAngle(EquippedWeapon->GetWeaponType(), HotState.CrosshairSpreadMultiplier) };
+		TArray<FVector, TInlineAllocator<16>> ShotDirections;
+		ShotDirections.SetNumUninitialized(NumPellets);
+		FShotSpread::SampleConeBatch(MuzzleToAim, SpreadHalfAngle, ShotRandom, ShotDirections);
+
+		// shots due earlier in the frame leave from where the muzzle was at that time
+		TArray<FVector, TInlineAllocator<16>> ShotStarts;
+		ShotStarts.SetNumUninitialized(NumPellets);
+		const FVector Velocity{ GetVelocity() };
+		for (int32 Pellet = 0; Pellet < NumPellets; Pellet++)
+		{
+			ShotStarts[Pellet] = MuzzleLocation - Velocity * ShotAges[Pellet / PelletsPerShot];
+		}
+
+		TArray<FHitResult, TInlineAllocator<16>> HitResults;
+		HitResults.SetNum(NumPellets);
+		const float TraceDistance{ MuzzleToAim.Size() * 1.25f };
+		TraceShots(ShotStarts, ShotDirections, TraceDistance, HitResults);
+
+		// damage is resolved with every other hit this frame, summed per victim
+		UShooterDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UShooterDamageSubsystem>();
+
+		// pellets landing close together on the same component share one beam and impact
+		TArray<FVector, TInlineAllocator<16>> BeamEnds;
+		TArray<const UPrimitiveComponent*, TInlineAllocator<16>> BeamComponents;
+		for (int32 Pellet = 0; Pellet < NumPellets; Pellet++)
 		{
-			if (ImpactParticles)
+			const FHitResult& HitResult = HitResults[Pellet];
+			if (HitResult.bBlockingHit && DamageSubsystem)
+			{
+				DamageSubsystem->QueueHit(HitResult, ShotStarts[Pellet], EquippedWeapon->GetWeaponType(), GetController(), this);
+			}
+			if (!bSpawnEffects) continue;
+
+			const FVector BeamEnd{ HitResult.bBlockingHit ? HitResult.Location : ShotStarts[Pellet] + ShotDirections[Pellet] * TraceDistance };
+			const UPrimitiveComponent* BeamComponent{ HitResult.GetComponent() };
+			bool bClustered{ false };
+			for (int32 i = 0; i < BeamEnds.Num(); i++)
+			{
+				if (BeamComponents[i] == BeamComponent && FVector::DistSquared(BeamEnds[i], BeamEnd) <= FMath::Square(ImpactClusterRadius))
+				{
+					bClustered = true;
+					break;
+				}
+			}
+			if (bClustered) continue;
+
+			BeamEnds.Add(BeamEnd);
+			BeamComponents.Add(BeamComponent);
+
+			if (ImpactParticles && HitResult.bBlockingHit)
 			{
 				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, BeamEnd);
 			}
@@ -578,9 +691,39 @@ void AShooterCharacter::SendBullet()
 		}
 	}
 }
+void AShooterCharacter::PlayHitReactMontage()
+{
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	if (AnimInstance && HitReactMontage && !AnimInstance->Montage_IsPlaying(HitReactMontage))
+	{
+		AnimInstance->Montage_Play(HitReactMontage);
+	}
+}
+void AShooterCharacter::Die()
+{
+	bDying = true;
+
+	// a dead character stops firing, even with shots still queued or the button held
+	HotState.bFireButtonPressed = false;
+	HotState.FireScheduler.CancelShots();
+
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	if (AnimInstance && DeathMontage)
+	{
+		AnimInstance->Montage_Play(DeathMontage);
+	}
+
+	if (APlayerController* PlayerController = Cast<APlayerController>(GetController()))
+	{
+		DisableInput(PlayerController);
+	}
+	GetCharacterMovement()->DisableMovement();
+}
 void AShooterCharacter::PlayGunfireMontage()
 {
 	//Play GunFire montage
+	if (!ShooterShouldRunCosmetics(GetWorld())) return;
+
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 	if (AnimInstance && HipFireMontage)
 	{
@@ -594,12 +737,16 @@ void AShooterCharacter::ReloadButtonPressed()
 }
 void AShooterCharacter::ReloadWeapon()
 {
-	if (CombatState != ECombatState::ECS_Unoccupied) return;
+	if (HotState.CombatState != ECombatState::ECS_Unoccupied) return;
 	if (EquippedWeapon == nullptr) return;
 	//do we have the ammor of the correct type?
 	if (CarryingAmmo() && !EquippedWeapon->ClipIsFull()) 
 	{
-		CombatState = ECombatState::ECS_Reloading;
+		SetCombatState(ECombatState::ECS_Reloading);
+
+		// a press in the same frame as the reload may have armed shots before UpdateFire saw them
+		HotState.FireScheduler.CancelShots();
+
 		UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 		if (AnimInstance && ReloadMontage)
 		{
@@ -609,31 +756,24 @@ void AShooterCharacter::ReloadWeapon()
 	}
 
 }
-bool AShooterCharacter::CarryingAmmo()
+bool AShooterCharacter::CarryingAmmo() const
 {
 	if (EquippedWeapon == nullptr) return false;
 
-	auto AmmoType = EquippedWeapon->GetAmmoType();
-
-	if (AmmoMap.Contains(AmmoType))
-	{
-		return AmmoMap[AmmoType] > 0;
-	}
-
-	return false;
+	return FCombatRules::GetCarriedAmmo(AmmoMap, EquippedWeapon->GetAmmoType()) > 0;
 }
 void AShooterCharacter::GrabClip()
 {
 	if (EquippedWeapon == nullptr || HandSceneComponent == nullptr) return;
 
-	// index for the clip bone on the equipped weapon
-	int32 ClipBoneIndex{ EquippedWeapon->GetItemMesh()->GetBoneIndex(EquippedWeapon->GetClipBoneName()) };
+	// index for the clip bone on the equipped weapon, cached in EquipWeapon
+	const int32 ClipBoneIndex{ EquippedWeapon->GetClipBoneIndex() };
+	if (ClipBoneIndex == INDEX_NONE) return;
+
 	// store the transform of the clip
 	ClipTransform = EquippedWeapon->GetItemMesh()->GetBoneTransform(ClipBoneIndex);
 
-	FAttachmentTransformRules AttachmentRules(EAttachmentRule::KeepRelative, true);
-
-	HandSceneComponent->AttachToComponent(GetMesh(), AttachmentRules, FName(TEXT("Hand_L")));
+	// HandSceneComponent is already attached to Hand_L
 	HandSceneComponent->SetWorldTransform(ClipTransform);
 
 	EquippedWeapon->SetMovingClip(true);
@@ -645,75 +785,69 @@ void AShooterCharacter::ReleaseClip()
 }
 void AShooterCharacter::CrouchButtonPressed()
 {
-	if(!GetCharacterMovement()->IsFalling())
-	{
-		bCrouching = !bCrouching;
-	}
-	if (bCrouching)
+	// speed, friction and capsule height follow from the flag in the movement component
+	if(!ShooterMovement->IsFalling())
 	{
-		GetCharacterMovement()->MaxWalkSpeed = CrouchMovementSpeed;
-	}
-	else
-	{
-		GetCharacterMovement()->MaxWalkSpeed = BaseMovementSpeed;
+		ShooterMovement->SetWantsToShooterCrouch(!ShooterMovement->IsShooterCrouching());
 	}
 }
 void AShooterCharacter::Jump()
 {
-	if (bCrouching)
+	if (ShooterMovement->IsShooterCrouching())
 	{
-		bCrouching = false;
-		GetCharacterMovement()->MaxWalkSpeed = BaseMovementSpeed;
+		ShooterMovement->SetWantsToShooterCrouch(false);
 	}
 	else
 	{
 		ACharacter::Jump();
 	}
 }
-void AShooterCharacter::InterpCapsuleHalfHeight(float DeltaTime)
+// Called every frame
+void AShooterCharacter::Tick(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterTick);
 
-	float TargetCapsuleHalfHeight{};
-	if (bCrouching)
-	{
-		TargetCapsuleHalfHeight = CrouchingCapsuleHalfHeight;
-	}
-	else
+	Super::Tick(DeltaTime);
+
+	const bool bRunCosmetics{ ShooterShouldRunCosmetics(GetWorld()) };
+
+	// handle interpolation for zoom when aiming
+	if (bRunCosmetics)
 	{
-		TargetCapsuleHalfHeight = StandingCapsuleHalfHeight;
+		CameraInterpZoom(DeltaTime);
 	}
-	const float InterpHalfHeight{ FMath::FInterpTo(GetCapsuleComponent()->GetScaledCapsuleHalfHeight(), TargetCapsuleHalfHeight, DeltaTime, 20.f) };
 
-	// negative value if crouching, positive value if standing
-	const float DeltaCapsuleHalfHeight{ InterpHalfHeight - GetCapsuleComponent()->GetScaledCapsuleHalfHeight() };
+	// fire every shot that came due this frame
+	UpdateFire(DeltaTime);
 
-	const FVector MeshOffset{ 0.f, 0.f, -DeltaCapsuleHalfHeight };
-	GetMesh()->AddLocalOffset(MeshOffset);
+	//calculate crosshair spread multiplier
+	CalculateCrosshairSpread(DeltaTime);
 
-	GetCapsuleComponent()->SetCapsuleHalfHeight(InterpHalfHeight);
+	//check for OverlappedItemCount, then trace for items under the crosshairs; the pickup widgets only where they are seen
+	TraceForItems(bRunCosmetics);
 
+	// one write per field per frame for the Blueprints that read them
+	bAiming = HotState.bAiming;
+	CrosshairSpreadMultiplier = HotState.CrosshairSpreadMultiplier;
+	CombatState = HotState.CombatState;
 }
-// Called every frame
-void AShooterCharacter::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-	
-	// handle interpolation for zoom when aiming
-	CameraInterpZoom(DeltaTime);
-
-	//Change look sensitivity based on aiming
-	SetLookRates();
 
-	//calculate crosshair spread multiplier
-	CalculateCrosshairSpread(DeltaTime);
+float AShooterCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+{
+	if (bDying) return 0.f;
 
-	//check for OverlappedItemCount, then trace for items
-	TraceForItems();
+	const float DamageApplied = FMath::Min(Health, Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser));
+	Health -= DamageApplied;
 
-	// interp the capsule half height based on crouching or standing
-	InterpCapsuleHalfHeight(DeltaTime);
-	
-	
+	if (Health <= 0.f)
+	{
+		Die();
+	}
+	else
+	{
+		PlayHitReactMontage();
+	}
+	return DamageApplied;
 }
 
 // Called to bind functionality to input
@@ -754,7 +888,7 @@ void AShooterCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
 void AShooterCharacter::FinishReloading()
 {
 	// update the combat state
-	CombatState = ECombatState::ECS_Unoccupied;
+	SetCombatState(ECombatState::ECS_Unoccupied);
 
 	if (EquippedWeapon == nullptr) return;
 
@@ -763,46 +897,89 @@ void AShooterCharacter::FinishReloading()
 	//update the AmmoMap
 	if (AmmoMap.Contains(AmmoType))
 	{
-		// amount of ammo the character is carrying of the EquipedWeapon type
-		int32 CarriedAmmo = AmmoMap[AmmoType];
+		// fill the magazine from the ammo carried for the EquippedWeapon type, as far as it goes
+		int32& CarriedAmmo = AmmoMap[AmmoType];
+		const int32 ReloadAmount{ FCombatRules::GetReloadAmount(EquippedWeapon->GetAmmo(), EquippedWeapon->GetMagazineCapacity(), CarriedAmmo) };
+		EquippedWeapon->ReloadAmmo(ReloadAmount);
+		CarriedAmmo -= ReloadAmount;
+		PushHUDAmmo();
+
+		// rounds that went into the magazine
+		FShooterTelemetry::Record(EShooterTelemetryEventType::Reload, GetUniqueID(), GetActorLocation(), static_cast<uint8>(EquippedWeapon->GetWeaponType()), static_cast<uint16>(ReloadAmount));
+	}
+}
 
-		// space left in the magazine if EquippedWeapon
-		const int32 MagEmptySpace = EquippedWeapon->GetMagazineCapacity() - EquippedWeapon->GetAmmo();
+float AShooterCharacter::GetCrosshairSpreadMultiplier() const
+{
+	return HotState.CrosshairSpreadMultiplier;
+}
 
-		if (MagEmptySpace > CarriedAmmo)
-		{
-			//reload the magazine with all the ammo we are carrying
-			EquippedWeapon->ReloadAmmo(CarriedAmmo);
-			CarriedAmmo = 0;
-			AmmoMap.Add(AmmoType, CarriedAmmo);
-		}
-		else
-		{
-			// fill the magazine
-			EquippedWeapon->ReloadAmmo(MagEmptySpace);
-			CarriedAmmo -= MagEmptySpace;
-			AmmoMap.Add(AmmoType, CarriedAmmo);
-		}
+int32 AShooterCharacter::GetCarriedAmmo() const
+{
+	if (EquippedWeapon == nullptr) return 0;
+
+	return FCombatRules::GetCarriedAmmo(AmmoMap, EquippedWeapon->GetAmmoType());
+}
+
+void AShooterCharacter::PushHUDAmmo()
+{
+	if (AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(GetController()))
+	{
+		const int32 Ammo = EquippedWeapon ? EquippedWeapon->GetAmmo() : 0;
+		ShooterController->SetHUDAmmo(Ammo, GetCarriedAmmo());
 	}
 }
 
-float AShooterCharacter::GetCrosshairSpreadMultiplier() const
+void AShooterCharacter::PushHUDState()
 {
-	return CrosshairSpreadMultiplier;
+	if (AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(GetController()))
+	{
+		HotState.BroadcastCrosshairSpreadMultiplier = HotState.CrosshairSpreadMultiplier;
+		ShooterController->SetHUDCrosshairSpread(HotState.CrosshairSpreadMultiplier);
+		ShooterController->SetHUDCombatState(HotState.CombatState);
+		ShooterController->SetHUDAiming(HotState.bAiming);
+		PushHUDAmmo();
+	}
 }
 
-void AShooterCharacter::IncrementOverlappedItemCount(int8 Amount)
+void AShooterCharacter::SetCombatState(ECombatState State)
 {
-	if (OverlappedItemCount + Amount <= 0)
+	HotState.CombatState = State;
+
+	if (AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(GetController()))
 	{
-		OverlappedItemCount = 0;
-		bShouldTraceForItems = false;
+		ShooterController->SetHUDCombatState(HotState.CombatState);
 	}
-	else
+}
+
+void AShooterCharacter::RestoreLoadout(const TMap<EAmmoType, int32>& Ammo, AWeapon* Weapon)
+{
+	// a reload in flight would finish into the restored weapon
+	if (HotState.CombatState == ECombatState::ECS_Reloading)
 	{
-		OverlappedItemCount += Amount;
-		bShouldTraceForItems = true;
+		StopAnimMontage(ReloadMontage);
 	}
+	SetCombatState(ECombatState::ECS_Unoccupied);
+
+	if (EquippedWeapon && EquippedWeapon != Weapon)
+	{
+		EquippedWeapon->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+		if (UPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UPickupPoolSubsystem>())
+		{
+			PickupPool->ReleaseItem(EquippedWeapon);
+		}
+		EquippedWeapon = nullptr;
+	}
+
+	AmmoMap = Ammo;
+	EquipWeapon(Weapon);
+	PushHUDAmmo();
+}
+
+void AShooterCharacter::IncrementOverlappedItemCount(int8 Amount)
+{
+	HotState.OverlappedItemCount = FCombatRules::GetOverlapCountAfter(HotState.OverlappedItemCount, Amount);
+	HotState.bShouldTraceForItems = HotState.OverlappedItemCount > 0;
 }
 
 FVector AShooterCharacter::GetCameraInterpLocation()
@@ -815,31 +992,37 @@ FVector AShooterCharacter::GetCameraInterpLocation()
 
 void AShooterCharacter::GetPickupItem(AItem* Item)
 {
-	if (Item->GetEquipSound())
+	FShooterTelemetry::Record(EShooterTelemetryEventType::Pickup, GetUniqueID(), Item->GetActorLocation());
+
+	UShooterAudioSubsystem* AudioSubsystem = GetWorld()->GetSubsystem<UShooterAudioSubsystem>();
+	if (AudioSubsystem && Item->GetEquipSound())
 	{
-		UGameplayStatics::PlaySound2D(this, Item->GetEquipSound());
+		AudioSubsystem->PlaySoundAtLocation(Item->GetEquipSound(), GetActorLocation());
 	}
 	auto Weapon = Cast<AWeapon>(Item);
 	if (Weapon)
 	{
 		SwapWeapon(Weapon);
 	}
+	else if (UPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UPickupPoolSubsystem>())
+	{
+		// non weapon items are consumed on pickup, recycle the actor
+		PickupPool->ReleaseItem(Item);
+	}
 }
 
 void AShooterCharacter::RequestSprintStart()
 {
-	if (GetCharacter())
-	{
-		GetCharacter()->GetCharacterMovement()->MaxWalkSpeed += SprintSpeed;
-	}
-
+	ShooterMovement->SetWantsToSprint(true);
 }
 
 void AShooterCharacter::RequestSprintEnd()
 {
-	if (GetCharacter())
-	{
-		GetCharacter()->GetCharacterMovement()->MaxWalkSpeed -= SprintSpeed;
-	}
+	ShooterMovement->SetWantsToSprint(false);
+}
+
+bool AShooterCharacter::GetCrouching() const
+{
+	return ShooterMovement && ShooterMovement->IsShooterCrouching();
 }
 
@@ -5,19 +5,12 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "AmmoType.h"
+#include "CombatState.h"
+#include "ShotSpread.h"
+#include "ShooterCharacterHotState.h"
 #include "ShooterCharacter.generated.h"
 
 
-UENUM(BlueprintType)
-enum class ECombatState : uint8
-{
-	ECS_Unoccupied UMETA(DisplayName = "Unoccupied"),
-	ECS_FireTimerInProgress UMETA(DisplayName = "FireTimerInProgress"),
-	ECS_Reloading UMETA(DisplayName = "Reloading"),
-
-	ECS_MAX UMETA(DisplayName = "DefaultMax")
-};
-
 UCLASS()
 class SHOOTER_API AShooterCharacter : public ACharacter
 {
@@ -25,7 +18,7 @@ class SHOOTER_API AShooterCharacter : public ACharacter
 
 public:
 	// Sets default values for this character's properties
-	AShooterCharacter();
+	AShooterCharacter(const FObjectInitializer& ObjectInitializer);
 
 protected:
 
@@ -55,15 +48,14 @@ protected:
 	//@param value   The input value from mouse movement
 	void LookUp(float Value);
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	float SprintSpeed = 1200.f;
-
-	/** Getter for Character */
-	FORCEINLINE ACharacter* GetCharacter() const { return Character; }
+	// fires every shot the scheduler emitted this frame as one batch; ShotAges are seconds since each shot was due
+	void FireWeapon(TArrayView<const float> ShotAges);
 
-	void FireWeapon();
+	// location under the crosshairs that shots are aimed at
+	void GetAimLocation(FVector& OutAimLocation);
 
-	bool GetBeamEndLocation(const FVector& MuzzleSocketLocation, FVector& OutBeamLocation);
+	// traces every shot as one batch, against the world and then the hitboxes
+	void TraceShots(TArrayView<const FVector> ShotStarts, TArrayView<const FVector> ShotDirections, float TraceDistance, TArrayView<FHitResult> OutHitResults);
 
 	// set bAiming to true or false with button press
 	void AimingButtonPressed();
@@ -72,18 +64,13 @@ protected:
 
 	void CameraInterpZoom(float DeltaTime);
 
-	// set base turn rate and base look up rate based on aiming
-	void SetLookRates();
-
 	void CalculateCrosshairSpread(float DeltaTime);
 
 	void FireButtonPressed();
 	void FireButtonReleased();
 
-	void StartFireTimer();
-
-	UFUNCTION()
-	void AutoFireReset();
+	// advances the fire scheduler and fires the shots due this frame
+	void UpdateFire(float DeltaTime);
 
 	// line trace for items under the crosshairs
 	bool TraceUnderCrosshairs(FHitResult& OutHitResult, FVector& OutHitLocation);
@@ -93,8 +80,8 @@ protected:
 	UFUNCTION()
 	void FinishCrosshairBulletFire();
 
-	// trace for items if OverlappedItemCount > 0
-	void TraceForItems();
+	// trace for items if OverlappedItemCount > 0; the pickup widgets are only updated when bUpdatePickupWidgets is set
+	void TraceForItems(bool bUpdatePickupWidgets);
 
 	// spawns default weapon and equips it 
 	class AWeapon* SpawnDefaultWeapon();
@@ -118,15 +105,13 @@ protected:
 	bool WeaponHasAmmo();
 	//FireWeapon functions
 	void PlayFireSound();
-	void SendBullet();
+	void SendBullets(TArrayView<const float> ShotAges);
 	void PlayGunfireMontage();
 	//Bound to the R key and gamepad face button left
 	void ReloadButtonPressed();
 	//handle reloading of the weapon
 	void ReloadWeapon();
 
-	// Checks to see if we have ammo of the EquippedWeapon's ammo type
-	bool CarryingAmmo();
 
 	// called from animation blueprint with the grab clip notify
 	UFUNCTION(BlueprintCallable)
@@ -140,25 +125,49 @@ protected:
 
 	virtual void Jump() override;
 
-	// interps capsule half height when crouching/standing
-	void InterpCapsuleHalfHeight(float DeltaTime);
-
-	UPROPERTY()
-		ACharacter* Character;
-
 	void RequestSprintStart();
 
 	void RequestSprintEnd();
 
 
+	// kicks the control rotation by the equipped weapon's recoil pattern
+	void ApplyRecoil();
+
+	// plays the hit react montage if one isn't already playing
+	void PlayHitReactMontage();
+
+	// disables input and plays the death montage
+	void Die();
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	// damage is applied in batches by UShooterDamageSubsystem
+	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
+
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 private:
+	// per-tick combat and camera state, kept together in one cache line
+	FShooterCharacterHotState HotState;
+
+	// copies of HotState's fields that Blueprints read, under their old names so existing graphs keep working;
+	// written once at the end of each tick, so the tick itself only touches the hot line
+
+	// true when aiming
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "True"))
+	bool bAiming;
+
+	// Determines the spread of the crosshairs
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Crossahairs, meta = (AllowPrivateAccess = "True"))
+	float CrosshairSpreadMultiplier;
+
+	// Combat state, can only fire or reload if unoccupied 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	ECombatState CombatState;
+
 	// Camera Boom positioning the camera begind the character
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"))
 	class USpringArmComponent* CameraBoom;
@@ -167,50 +176,18 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"))
 	class UCameraComponent* FollowCamera;
 	
-	// base turn rate, in deg/sec other scaling may affect final turn rate 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"))
-	float BaseTurnRate;
-
-	// base look up/down rate in deg/sec other scaling may affect final turn rate
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"))
-	float BaseLookUpRate;
-
-	// turn rate while not aiming
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"))
-	float HipTurnRate;
-
-	// look up rate while not aiming
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"))
-	float HipLookUpRate;
-
-	//turn rate when aiming
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"))
-	float AimingTurnRate;
-
-	//look up rate when aiming
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"))
-	float AimingLookUpRate;
-
-	// scale factor for mouse look sensitivity. turn rate when not aiming
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"), meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
-	float MouseHipTurnRate;
-	
-	//scale factor for mouse look sensitivity look up rate when not aiming
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"), meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
-	float MouseHipLookUpRate;
-
-	// scale  factor  for mouse look sensitivity   turn rate when aiming
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"), meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
-	float MouseAimingTurnRate;
-
-	// scale factor for mouse look sensitivity     look up rate when aiming
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "True"), meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
-	float MouseAimingLookUpRate;
-
 	// Randomized Gunshot sound cue
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "True"))
 	class USoundCue* FireSound;
 
+	// looped while firing full auto; without one, every shot plays FireSound
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "True"))
+	USoundCue* FireLoopSound;
+
+	// played when a full auto loop ends
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "True"))
+	USoundCue* FireTailSound;
+
 	// Flash spawned at barrelsocket
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "True"))
 	class UParticleSystem* MuzzleFlash;
@@ -227,71 +204,18 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "True"))
 	UParticleSystem* BeamParticles;
 
-	// true when aiming
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "True"))
-	bool bAiming;
-
-	//default camera feild of view value
-	float CameraDefaultFOV;
-
-	// feild of view value for when zoomed in 
-	float CameraZoomedFOV;
-
-	// current field of view this frame
-	float CameraCurrentFOV;
-
-	// interp speed for zooming when aiming
+	// pellets landing within this distance on the same component share one impact effect
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "True"))
-	float ZoomInterpSpeed;
-
-	// Determines the spread of the crosshairs
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Crossahairs, meta = (AllowPrivateAccess = "True"))
-	float CrosshairSpreadMultiplier;
-
-	// velocity component for crosshair spread
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Crossahairs, meta = (AllowPrivateAccess = "True"))
-	float CrosshairVelocityFactor;
-
-	// in air component for crosshair spread
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Crossahairs, meta = (AllowPrivateAccess = "True"))
-	float CrosshairInAirFactor;
-
-	//aim component for crosshair spread
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Crossahairs, meta = (AllowPrivateAccess = "True"))
-	float CrosshairAimFactor;
-	
-	//shooting component for crosshair spread
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Crossahairs, meta = (AllowPrivateAccess = "True"))
-	float CrosshairShootingFactor;
+	float ImpactClusterRadius;
 
+	// the HUD state is only updated once the spread moves this far from the last pushed value
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Crossahairs, meta = (AllowPrivateAccess = "True"))
+	float CrosshairSpreadBroadcastThreshold;
 
+	// how long bFiringBullet stays set after each shot
 	float ShootTimeDuration;
-	bool bFiringBullet;
 	FTimerHandle CrosshairShootTimer;
 
-	
-
-
-	// Rate of Automatic Gunfire
-	float AutomaticFireRate;
-
-	// True when we can fire. False when waiting for the timer
-	bool bShouldFire;
-
-	// left mouse button or right console trigger  pressed
-	bool bFireButtonPressed;
-
-	
-
-	//Sets a timer between gunshots
-	FTimerHandle AutoFireTimer;
-
-	//True if we should trace every frame for items
-	bool bShouldTraceForItems;
-
-	//number of overlapped AItems
-	int8 OverlappedItemCount;
-
 	// The AItem we hit last frame
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
 	class AItem* TraceHitItemLastFrame;
@@ -327,9 +251,10 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Items, meta = (AllowPrivateAccess = "true"))
 	int32 StartingARAmmo;
 
-	// Combat state, can only fire or reload if unoccupied 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
-	ECombatState CombatState;
+	// starting amount of shotgun shells
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Items, meta = (AllowPrivateAccess = "true"))
+	int32 StartingShellAmmo;
+
 
 	// montage for reload animations
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
@@ -346,37 +271,36 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	USceneComponent* HandSceneComponent;
 
-	//true when crouching
+	// the character movement component; owns sprint, crouch and the capsule height
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	bool bCrouching;
+	class UShooterMovementComponent* ShooterMovement;
 
-	// regular movement speed
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	float BaseMovementSpeed;
+	// current health, the character dies at zero
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float Health;
 
-	// regular crouching speed
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	float CrouchMovementSpeed;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float MaxHealth;
+
+	// montage played when hit by a bullet
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	UAnimMontage* HitReactMontage;
 
-	// current half height of the capsule
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	float CurrentCapsuleHalfHeight;
+	// montage played when health reaches zero
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	UAnimMontage* DeathMontage;
 
-	// half height of the capsule when not crouching
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	float StandingCapsuleHalfHeight;
+	// true once health has reached zero
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	bool bDying;
 
-	// half height of the capsule when crouching
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	float CrouchingCapsuleHalfHeight;
+	// seeded generator for shot spread
+	FShotRandom ShotRandom;
 
-	// ground friction while not crouching
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	float BaseGroundFriction;
 
-	// ground friction while crouching
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Movement, meta = (AllowPrivateAccess = "true"))
-	float CrouchingGroundFriction;
+	// simplified per-bone capsules that bullets trace against
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	class UShooterHitboxComponent* HitboxComponent;
 
 
 
@@ -386,12 +310,12 @@ public:
 	// Returns FollowCamera subobject
 	FORCEINLINE UCameraComponent* GetFollowCamera() const { return FollowCamera; }
 
-	FORCEINLINE bool GetAiming() const { return bAiming; }
+	FORCEINLINE bool GetAiming() const { return HotState.bAiming; }
 
 	UFUNCTION(BlueprintCallable)
 	float GetCrosshairSpreadMultiplier() const;
 
-	FORCEINLINE int8 GetOverlappedItemCount() const { return OverlappedItemCount; }
+	FORCEINLINE int8 GetOverlappedItemCount() const { return HotState.OverlappedItemCount; }
 
 	// adds/subtracts to/from OverLappedItemCount and updates bShouldTracefor items
 	void IncrementOverlappedItemCount(int8 Amount);
@@ -400,7 +324,32 @@ public:
 
 	void GetPickupItem(AItem* Item);
 
-	FORCEINLINE ECombatState GetCombatState() const { return CombatState; }
-	FORCEINLINE bool GetCrouching() const { return bCrouching; }
+	FORCEINLINE ECombatState GetCombatState() const { return HotState.CombatState; }
+	bool GetCrouching() const;
+	FORCEINLINE UShooterMovementComponent* GetShooterMovement() const { return ShooterMovement; }
+	FORCEINLINE AWeapon* GetEquippedWeapon() const { return EquippedWeapon; }
+	FORCEINLINE float GetHealth() const { return Health; }
+	FORCEINLINE float GetMaxHealth() const { return MaxHealth; }
+	FORCEINLINE bool GetDying() const { return bDying; }
+
+	// ammo carried for the equipped weapon's ammo type
+	int32 GetCarriedAmmo() const;
+
+	// Checks to see if we have ammo of the EquippedWeapon's ammo type
+	bool CarryingAmmo() const;
+
+	// writes the equipped weapon's ammo and the carried ammo to the controller's HUD state
+	void PushHUDAmmo();
+
+	// writes every HUD value at once; used when the character is possessed
+	void PushHUDState();
+
+	// sets CombatState and mirrors it to the HUD state
+	void SetCombatState(ECombatState State);
+
+	FORCEINLINE const TMap<EAmmoType, int32>& GetAmmoMap() const { return AmmoMap; }
+
+	// replaces the carried ammo and the equipped weapon with a checkpoint's; the old weapon goes back to the pickup pool
+	void RestoreLoadout(const TMap<EAmmoType, int32>& Ammo, AWeapon* Weapon);
 
 };
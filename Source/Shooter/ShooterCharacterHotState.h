@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatState.h"
+#include "CombatRules.h"
+#include "FireScheduler.h"
+
+/**
+ * Everything AShooterCharacter reads or writes every tick, packed into one cache line. Tuning lives in
+ * UShooterTuningSettings and assets stay on the character, so a tick doesn't drag either into cache.
+ */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FShooterCharacterHotState
+{
+	// velocity, in air, aim and shooting components of the crosshair spread
+	FCrosshairSpread CrosshairSpread;
+
+	// sum of the crosshair spread components, and the value last pushed to the HUD state
+	float CrosshairSpreadMultiplier = 0.f;
+	float BroadcastCrosshairSpreadMultiplier = 0.f;
+
+	// camera FOV when not aiming (read from the camera in BeginPlay), this frame's FOV, and the FOV being eased toward
+	float CameraDefaultFOV = 0.f;
+	float CameraCurrentFOV = 0.f;
+	float CameraTargetFOV = 0.f;
+
+	// fires the equipped weapon's shots at its fire interval, independent of the framerate
+	FFireScheduler FireScheduler;
+
+	// shots fired since the fire button was pressed; indexes the recoil pattern
+	int32 RecoilShotIndex = 0;
+
+	// can only fire or reload if unoccupied
+	ECombatState CombatState = ECombatState::ECS_Unoccupied;
+
+	// number of overlapped AItems
+	int8 OverlappedItemCount = 0;
+
+	bool bAiming = false;
+
+	// the camera is only touched while the FOV is easing
+	bool bZoomInFlight = false;
+
+	// true for a short while after each shot; widens the crosshairs
+	bool bFiringBullet = false;
+
+	// left mouse button or right console trigger pressed
+	bool bFireButtonPressed = false;
+
+	// true if we should trace every frame for items
+	bool bShouldTraceForItems = false;
+};
+static_assert(sizeof(FShooterCharacterHotState) == PLATFORM_CACHE_LINE_SIZE, "FShooterCharacterHotState should fill exactly one cache line");
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterDamageSubsystem.h"
+#include "Shooter.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/Controller.h"
+#include "Engine/EngineTypes.h"
+#include "ShooterTelemetry.h"
+
+DECLARE_CYCLE_STAT(TEXT("Resolve Hits"), STAT_ShooterResolveHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hits Resolved"), STAT_ShooterHitsResolved, STATGROUP_Shooter);
+
+namespace
+{
+	// damage tuning for one weapon type
+	struct FWeaponDamageProfile
+	{
+		float BaseDamage;
+		float HeadshotMultiplier;
+		// full damage up to FalloffStart, scaling down to MinDamageScale at FalloffEnd
+		float FalloffStart;
+		float FalloffEnd;
+		float MinDamageScale;
+	};
+
+	// indexed by EWeaponType
+	constexpr FWeaponDamageProfile WeaponDamageProfiles[] =
+	{
+		// SubmachineGun
+		{ 15.f, 2.f, 1'000.f, 3'000.f, 0.4f },
+		// AssaultRifle
+		{ 22.f, 2.5f, 2'500.f, 6'000.f, 0.5f },
+		// Shotgun, per pellet
+		{ 12.f, 1.5f, 500.f, 1'500.f, 0.2f },
+	};
+	static_assert(UE_ARRAY_COUNT(WeaponDamageProfiles) == static_cast<int32>(EWeaponType::EWT_MAX), "WeaponDamageProfiles needs an entry per EWeaponType");
+
+	const FName HeadBoneName{ TEXT("head") };
+	const FName NeckBoneName{ TEXT("neck_01") };
+}
+
+void UShooterDamageSubsystem::QueueHit(const FHitResult& HitResult, const FVector& ShotStart, EWeaponType WeaponType, AController* InstigatorController, AActor* DamageCauser)
+{
+	AActor* Victim = HitResult.GetActor();
+	if (Victim == nullptr || !Victim->CanBeDamaged()) return;
+
+	FPendingHit& Hit = PendingHits.AddDefaulted_GetRef();
+	Hit.Victim = Victim;
+	Hit.InstigatorController = InstigatorController;
+	Hit.DamageCauser = DamageCauser;
+	Hit.HitResult = HitResult;
+	Hit.ShotDirection = (HitResult.ImpactPoint - ShotStart).GetSafeNormal();
+	Hit.Distance = FVector::Dist(ShotStart, HitResult.ImpactPoint);
+	Hit.WeaponType = WeaponType;
+}
+
+float UShooterDamageSubsystem::ResolveDamage(EWeaponType WeaponType, float Distance, const FName& BoneName)
+{
+	const int32 ProfileIndex = FMath::Clamp(static_cast<int32>(WeaponType), 0, static_cast<int32>(EWeaponType::EWT_MAX) - 1);
+	const FWeaponDamageProfile& Profile = WeaponDamageProfiles[ProfileIndex];
+
+	const float FalloffScale = FMath::GetMappedRangeValueClamped(FVector2D(Profile.FalloffStart, Profile.FalloffEnd), FVector2D(1.f, Profile.MinDamageScale), Distance);
+	const bool bHeadshot = BoneName == HeadBoneName || BoneName == NeckBoneName;
+
+	return Profile.BaseDamage * FalloffScale * (bHeadshot ? Profile.HeadshotMultiplier : 1.f);
+}
+
+void UShooterDamageSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterResolveHits);
+	INC_DWORD_STAT_BY(STAT_ShooterHitsResolved, PendingHits.Num());
+
+	// resolve every hit in one pass over contiguous data
+	const int32 NumHits = PendingHits.Num();
+	ResolvedDamage.SetNumUninitialized(NumHits, false);
+	for (int32 i = 0; i < NumHits; i++)
+	{
+		const FPendingHit& Hit = PendingHits[i];
+		ResolvedDamage[i] = ResolveDamage(Hit.WeaponType, Hit.Distance, Hit.HitResult.BoneName);
+
+		const AActor* Victim = Hit.Victim.Get();
+		FShooterTelemetry::Record(EShooterTelemetryEventType::Hit, Victim ? Victim->GetUniqueID() : 0, Hit.HitResult.ImpactPoint, static_cast<uint8>(Hit.WeaponType), 1, ResolvedDamage[i]);
+	}
+
+	// sum the damage per victim and instigator in one pass; the first hit of each pair carries the total
+	FirstHitIndices.Reset();
+	for (int32 i = 0; i < NumHits; i++)
+	{
+		const FPendingHit& Hit = PendingHits[i];
+		AActor* Victim = Hit.Victim.Get();
+		if (Victim == nullptr || ResolvedDamage[i] <= 0.f) continue;
+
+		const TPair<AActor*, AController*> Key(Victim, Hit.InstigatorController.Get());
+		if (const int32* FirstHitIndex = FirstHitIndices.Find(Key))
+		{
+			ResolvedDamage[*FirstHitIndex] += ResolvedDamage[i];
+			ResolvedDamage[i] = 0.f;
+		}
+		else
+		{
+			FirstHitIndices.Add(Key, i);
+		}
+	}
+
+	// one TakeDamage call per victim and instigator, in the order they were first hit
+	for (int32 i = 0; i < NumHits; i++)
+	{
+		const FPendingHit& Hit = PendingHits[i];
+		AActor* Victim = Hit.Victim.Get();
+		if (Victim == nullptr || ResolvedDamage[i] <= 0.f) continue;
+
+		// the first hit this frame drives the hit reaction
+		const FPointDamageEvent DamageEvent(ResolvedDamage[i], Hit.HitResult, Hit.ShotDirection, UDamageType::StaticClass());
+		Victim->TakeDamage(ResolvedDamage[i], DamageEvent, Hit.InstigatorController.Get(), Hit.DamageCauser.Get());
+	}
+
+	PendingHits.Reset();
+}
+
+ETickableTickType UShooterDamageSubsystem::GetTickableTickType() const
+{
+	// the CDO never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UShooterDamageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterDamageSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Weapon.h"
+#include "ShooterDamageSubsystem.generated.h"
+
+// a bullet hit waiting to be resolved at the end of the frame
+struct FPendingHit
+{
+	TWeakObjectPtr<AActor> Victim;
+	TWeakObjectPtr<AController> InstigatorController;
+	TWeakObjectPtr<AActor> DamageCauser;
+	FHitResult HitResult;
+	FVector ShotDirection;
+	float Distance;
+	EWeaponType WeaponType;
+};
+
+/**
+ * Collects every hit fired during the frame, resolves damage for all of them in one loop
+ * and then applies one TakeDamage call per victim and instigator, so kill credit stays with whoever fired
+ */
+UCLASS()
+class SHOOTER_API UShooterDamageSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	// queues a hit from a weapon trace; ignored if nothing damageable was hit
+	void QueueHit(const FHitResult& HitResult, const FVector& ShotStart, EWeaponType WeaponType, AController* InstigatorController, AActor* DamageCauser);
+
+	// damage a single hit would do, without applying it
+	static float ResolveDamage(EWeaponType WeaponType, float Distance, const FName& BoneName);
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return PendingHits.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	// hits collected this frame, in the order they were fired
+	TArray<FPendingHit> PendingHits;
+
+	// damage for PendingHits at the same index, filled by the resolve pass
+	TArray<float> ResolvedDamage;
+
+	// index of the first hit per victim and instigator, rebuilt by every aggregation pass
+	TMap<TPair<AActor*, AController*>, int32> FirstHitIndices;
+};
@@ -2,4 +2,26 @@
 
 
 #include "ShooterGameModeBase.h"
+#include "PickupPoolSubsystem.h"
+#include "Item.h"
+#include "ShooterHUD.h"
 
+AShooterGameModeBase::AShooterGameModeBase()
+{
+	HUDClass = AShooterHUD::StaticClass();
+}
+
+void AShooterGameModeBase::StartPlay()
+{
+	// warm the pickup pool for the map before any actor begins play, so the first spawns and drops are already pooled
+	if (UPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UPickupPoolSubsystem>())
+	{
+		for (const TPair<TSubclassOf<AItem>, int32>& PooledItem : PooledItemCounts)
+		{
+			PickupPool->WarmPool(PooledItem.Key, PooledItem.Value);
+		}
+		PickupPool->FlushPendingWarm();
+	}
+
+	Super::StartPlay();
+}
@@ -13,5 +13,13 @@ UCLASS()
 class SHOOTER_API AShooterGameModeBase : public AGameModeBase
 {
 	GENERATED_BODY()
-	
+public:
+	AShooterGameModeBase();
+
+	virtual void StartPlay() override;
+
+private:
+	// dormant items the pickup pool pre-spawns per class when the map loads
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
+	TMap<TSubclassOf<class AItem>, int32> PooledItemCounts;
 };
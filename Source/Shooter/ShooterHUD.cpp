@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterHUD.h"
+#include "ShooterPlayerController.h"
+#include "SShooterCrosshair.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/SInvalidationPanel.h"
+#include "Styling/CoreStyle.h"
+
+AShooterHUD::AShooterHUD() :
+	CrosshairBaseSpread(8.f),
+	CrosshairSpreadScale(16.f),
+	CrosshairColor(FLinearColor::White),
+	AmmoFontSize(32)
+{
+
+}
+
+void AShooterHUD::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GEngine && GEngine->GameViewport)
+	{
+		SAssignNew(RootWidget, SInvalidationPanel)
+		[
+			SNew(SOverlay)
+			+ SOverlay::Slot()
+			.HAlign(HAlign_Center)
+			.VAlign(VAlign_Center)
+			[
+				SAssignNew(CrosshairWidget, SShooterCrosshair)
+				.BaseSpread(CrosshairBaseSpread)
+				.SpreadScale(CrosshairSpreadScale)
+				.Color(CrosshairColor)
+			]
+			+ SOverlay::Slot()
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Bottom)
+			.Padding(FMargin(0.f, 0.f, 48.f, 32.f))
+			[
+				SAssignNew(AmmoText, STextBlock)
+				.Font(FCoreStyle::GetDefaultFontStyle("Bold", AmmoFontSize))
+			]
+		];
+
+		GEngine->GameViewport->AddViewportWidgetContent(RootWidget.ToSharedRef());
+	}
+
+	if (AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(PlayerOwner))
+	{
+		ShooterController->OnHUDStateChanged.AddDynamic(this, &AShooterHUD::OnHUDStateChanged);
+
+		// show whatever was pushed before the HUD existed
+		DisplayedState.Version = INDEX_NONE;
+		OnHUDStateChanged(ShooterController->GetHUDState());
+	}
+}
+
+void AShooterHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AShooterPlayerController* ShooterController = Cast<AShooterPlayerController>(PlayerOwner))
+	{
+		ShooterController->OnHUDStateChanged.RemoveDynamic(this, &AShooterHUD::OnHUDStateChanged);
+	}
+
+	if (RootWidget.IsValid() && GEngine && GEngine->GameViewport)
+	{
+		GEngine->GameViewport->RemoveViewportWidgetContent(RootWidget.ToSharedRef());
+	}
+	RootWidget.Reset();
+	CrosshairWidget.Reset();
+	AmmoText.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterHUD::OnHUDStateChanged(const FShooterHUDState& HUDState)
+{
+	if (HUDState.Version == DisplayedState.Version) return;
+
+	const bool bForceRefresh{ DisplayedState.Version == INDEX_NONE };
+
+	if (CrosshairWidget.IsValid() && (bForceRefresh || HUDState.CrosshairSpreadMultiplier != DisplayedState.CrosshairSpreadMultiplier))
+	{
+		CrosshairWidget->SetSpreadMultiplier(HUDState.CrosshairSpreadMultiplier);
+	}
+
+	if (AmmoText.IsValid() && (bForceRefresh || HUDState.Ammo != DisplayedState.Ammo || HUDState.CarriedAmmo != DisplayedState.CarriedAmmo))
+	{
+		AmmoText->SetText(FText::Format(NSLOCTEXT("ShooterHUD", "AmmoFormat", "{0} / {1}"), FText::AsNumber(HUDState.Ammo), FText::AsNumber(HUDState.CarriedAmmo)));
+	}
+
+	DisplayedState = HUDState;
+}
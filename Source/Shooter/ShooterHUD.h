@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/HUD.h"
+#include "ShooterHUDState.h"
+#include "ShooterHUD.generated.h"
+
+/**
+ * The whole in-game HUD: native crosshair and ammo display, with no UMG overlay on top. Nothing is polled; it observes the owning controller's HUD state.
+ */
+UCLASS()
+class SHOOTER_API AShooterHUD : public AHUD
+{
+	GENERATED_BODY()
+public:
+	AShooterHUD();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// updates only the widgets whose values differ from the last state we displayed
+	UFUNCTION()
+	void OnHUDStateChanged(const FShooterHUDState& HUDState);
+
+private:
+	// distance of the crosshair ticks from the center at zero spread
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Crosshairs, meta = (AllowPrivateAccess = "true"))
+	float CrosshairBaseSpread;
+
+	// extra crosshair distance per unit of spread multiplier
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Crosshairs, meta = (AllowPrivateAccess = "true"))
+	float CrosshairSpreadScale;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Crosshairs, meta = (AllowPrivateAccess = "true"))
+	FLinearColor CrosshairColor;
+
+	// font size of the ammo counter
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Ammo, meta = (AllowPrivateAccess = "true"))
+	int32 AmmoFontSize;
+
+	// last state shown; compared against so unrelated changes don't touch the widgets
+	FShooterHUDState DisplayedState;
+
+	// root widget added to the viewport, cached by an invalidation panel
+	TSharedPtr<class SWidget> RootWidget;
+	TSharedPtr<class SShooterCrosshair> CrosshairWidget;
+	TSharedPtr<class STextBlock> AmmoText;
+};
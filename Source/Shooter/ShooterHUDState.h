@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatState.h"
+#include "ShooterHUDState.generated.h"
+
+// everything the HUD shows about the local character; only written when a value changes
+USTRUCT(BlueprintType)
+struct FShooterHUDState
+{
+	GENERATED_BODY()
+
+	// ammo in the equipped weapon's magazine
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = HUD)
+	int32 Ammo = 0;
+
+	// ammo carried for the equipped weapon's ammo type
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = HUD)
+	int32 CarriedAmmo = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = HUD)
+	float CrosshairSpreadMultiplier = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = HUD)
+	ECombatState CombatState = ECombatState::ECS_Unoccupied;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = HUD)
+	bool bAiming = false;
+
+	// incremented on every change so observers can skip states they've already seen
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = HUD)
+	int32 Version = 0;
+};
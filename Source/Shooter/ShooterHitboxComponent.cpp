@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterHitboxComponent.h"
+#include "Shooter.h"
+#include "HitboxSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitbox Updates"), STAT_ShooterHitboxUpdates, STATGROUP_Shooter);
+
+namespace
+{
+	FHitboxDefinition MakeHitbox(const TCHAR* BoneName, float Radius, float HalfHeight, const FRotator& Rotation = FRotator::ZeroRotator)
+	{
+		FHitboxDefinition Definition;
+		Definition.BoneName = FName(BoneName);
+		Definition.Radius = Radius;
+		Definition.HalfHeight = HalfHeight;
+		Definition.Offset = FTransform(Rotation);
+		return Definition;
+	}
+}
+
+UShooterHitboxComponent::UShooterHitboxComponent() :
+	ActivationRadius(150.f),
+	LastUpdateFrame(0),
+	bHitboxCollisionEnabled(false)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// head, torso and limbs of the mannequin skeleton; limb capsules lie along the bone's X axis
+	const FRotator AlongBone{ 90.f, 0.f, 0.f };
+	HitboxDefinitions.Add(MakeHitbox(TEXT("head"), 12.f, 14.f));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("spine_03"), 20.f, 30.f));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("pelvis"), 18.f, 22.f));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("upperarm_l"), 7.f, 18.f, AlongBone));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("upperarm_r"), 7.f, 18.f, AlongBone));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("lowerarm_l"), 6.f, 18.f, AlongBone));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("lowerarm_r"), 6.f, 18.f, AlongBone));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("thigh_l"), 10.f, 25.f, AlongBone));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("thigh_r"), 10.f, 25.f, AlongBone));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("calf_l"), 8.f, 25.f, AlongBone));
+	HitboxDefinitions.Add(MakeHitbox(TEXT("calf_r"), 8.f, 25.f, AlongBone));
+}
+
+void UShooterHitboxComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	AActor* Owner = GetOwner();
+	if (Owner == nullptr || Hitboxes.Num() > 0 || !GetWorld()->IsGameWorld()) return;
+
+	for (const FHitboxDefinition& Definition : HitboxDefinitions)
+	{
+		// not attached to the bone, so animation never moves the capsule by itself
+		UCapsuleComponent* Hitbox = NewObject<UCapsuleComponent>(Owner, NAME_None, RF_Transient);
+		Hitbox->SetupAttachment(Owner->GetRootComponent());
+		Hitbox->SetUsingAbsoluteLocation(true);
+		Hitbox->SetUsingAbsoluteRotation(true);
+		Hitbox->SetUsingAbsoluteScale(true);
+		Hitbox->SetCapsuleSize(Definition.Radius, Definition.HalfHeight);
+		// enabled by the first UpdateHitboxes, once the capsule is on its bone
+		Hitbox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Hitbox->SetCollisionObjectType(ECollisionChannel::ECC_Pawn);
+		Hitbox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+		Hitbox->SetCollisionResponseToChannel(ECC_Hitbox, ECollisionResponse::ECR_Block);
+		Hitbox->SetGenerateOverlapEvents(false);
+		Hitbox->SetCanEverAffectNavigation(false);
+		Hitbox->RegisterComponent();
+		Hitboxes.Add(Hitbox);
+	}
+}
+
+void UShooterHitboxComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UHitboxSubsystem>())
+	{
+		HitboxSubsystem->RegisterHitboxes(this);
+	}
+}
+
+void UShooterHitboxComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UHitboxSubsystem>())
+	{
+		HitboxSubsystem->UnregisterHitboxes(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UShooterHitboxComponent::UpdateHitboxes()
+{
+	const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
+	const USkeletalMeshComponent* Mesh = OwnerCharacter ? OwnerCharacter->GetMesh() : nullptr;
+	if (Mesh == nullptr) return;
+
+	// capsules moved earlier this frame are still on the pose; they only need their collision back
+	if (LastUpdateFrame != GFrameCounter)
+	{
+		LastUpdateFrame = GFrameCounter;
+		INC_DWORD_STAT(STAT_ShooterHitboxUpdates);
+
+		for (int32 i = 0; i < Hitboxes.Num(); i++)
+		{
+			const FTransform BoneTransform{ HitboxDefinitions[i].Offset * Mesh->GetSocketTransform(HitboxDefinitions[i].BoneName) };
+			Hitboxes[i]->SetWorldLocationAndRotation(BoneTransform.GetLocation(), BoneTransform.GetRotation(), false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+
+	if (!bHitboxCollisionEnabled)
+	{
+		bHitboxCollisionEnabled = true;
+		for (UCapsuleComponent* Hitbox : Hitboxes)
+		{
+			Hitbox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		}
+	}
+}
+
+void UShooterHitboxComponent::DisableHitboxes()
+{
+	if (!bHitboxCollisionEnabled) return;
+	bHitboxCollisionEnabled = false;
+
+	for (UCapsuleComponent* Hitbox : Hitboxes)
+	{
+		Hitbox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+}
+
+FName UShooterHitboxComponent::GetHitboxBoneName(const UPrimitiveComponent* HitComponent) const
+{
+	for (int32 i = 0; i < Hitboxes.Num(); i++)
+	{
+		if (Hitboxes[i] == HitComponent)
+		{
+			return HitboxDefinitions[i].BoneName;
+		}
+	}
+	return NAME_None;
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ShooterHitboxComponent.generated.h"
+
+// one capsule following a bone of the owner's mesh
+USTRUCT(BlueprintType)
+struct FHitboxDefinition
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hitbox)
+	FName BoneName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hitbox)
+	float Radius = 10.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hitbox)
+	float HalfHeight = 20.f;
+
+	// offset of the capsule relative to the bone
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hitbox)
+	FTransform Offset;
+};
+
+/**
+ * Simplified per-bone collision for bullet traces. The capsules only respond to ECC_Hitbox
+ * and are moved to the current pose lazily, when UHitboxSubsystem sees a shot pass nearby.
+ * Between updates their collision is off, so a trace can never hit a pose the owner has left.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SHOOTER_API UShooterHitboxComponent : public UActorComponent
+{
+	GENERATED_BODY()
+public:
+	UShooterHitboxComponent();
+
+	// moves every capsule to its bone, if not already done this frame, and lets traces hit them
+	void UpdateHitboxes();
+
+	// stops traces hitting the capsules until the next UpdateHitboxes
+	void DisableHitboxes();
+
+	// bone the hitbox capsule follows, NAME_None if the component isn't one of ours
+	FName GetHitboxBoneName(const UPrimitiveComponent* HitComponent) const;
+
+	// radius around the owner that a shot has to pass through before the hitboxes are updated
+	FORCEINLINE float GetActivationRadius() const { return ActivationRadius; }
+
+protected:
+	virtual void OnRegister() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Hitbox, meta = (AllowPrivateAccess = "true"))
+	TArray<FHitboxDefinition> HitboxDefinitions;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Hitbox, meta = (AllowPrivateAccess = "true"))
+	float ActivationRadius;
+
+	// capsules created from HitboxDefinitions, same order
+	UPROPERTY(Transient)
+	TArray<class UCapsuleComponent*> Hitboxes;
+
+	// GFrameCounter of the last UpdateHitboxes
+	uint64 LastUpdateFrame;
+
+	// true while the capsules block ECC_Hitbox
+	bool bHitboxCollisionEnabled;
+};
@@ -0,0 +1,201 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "Shooter.h"
+#include "ShooterTuningSettings.h"
+
+namespace
+{
+	// the engine's crouch uses FLAG_WantsToCrouch; the shooter crouch eases the capsule instead, so it has its own
+	constexpr uint8 FLAG_WantsToSprint = FSavedMove_Character::FLAG_Custom_0;
+	constexpr uint8 FLAG_WantsToShooterCrouch = FSavedMove_Character::FLAG_Custom_1;
+}
+
+UShooterMovementComponent::UShooterMovementComponent() :
+	StandingCapsuleHalfHeight(88.f),
+	CrouchingCapsuleHalfHeight(44.f),
+	// no target yet, so the first move brings the capsule to its standing height
+	CapsuleTargetHalfHeight(-1.f),
+	bWantsToSprint(false),
+	bWantsToShooterCrouch(false),
+	bCapsuleInFlight(false)
+{
+	// speeds and frictions come from UShooterTuningSettings; these only seed the engine values before the first move
+	const FShooterTuning DefaultTuning;
+	MaxWalkSpeed = DefaultTuning.BaseMovementSpeed;
+	GroundFriction = DefaultTuning.BaseGroundFriction;
+}
+
+float UShooterMovementComponent::GetMaxSpeed() const
+{
+	if (MovementMode != MOVE_Walking && MovementMode != MOVE_NavWalking)
+	{
+		return Super::GetMaxSpeed();
+	}
+
+	const FShooterTuning& Tuning = UShooterTuningSettings::GetTuning();
+	if (bWantsToShooterCrouch)
+	{
+		return Tuning.CrouchMovementSpeed;
+	}
+	return bWantsToSprint ? Tuning.SprintSpeed : Tuning.BaseMovementSpeed;
+}
+
+void UShooterMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	bWantsToSprint = (Flags & FLAG_WantsToSprint) != 0;
+	bWantsToShooterCrouch = (Flags & FLAG_WantsToShooterCrouch) != 0;
+}
+
+FNetworkPredictionData_Client* UShooterMovementComponent::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UShooterMovementComponent* MutableThis = const_cast<UShooterMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Shooter(*this);
+	}
+	return ClientPredictionData;
+}
+
+void UShooterMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	// runs for every move on both the client and the server, so both derive the same friction and capsule
+	const FShooterTuning& Tuning = UShooterTuningSettings::GetTuning();
+	GroundFriction = bWantsToShooterCrouch ? Tuning.CrouchingGroundFriction : Tuning.BaseGroundFriction;
+	InterpCapsuleHalfHeight(DeltaSeconds);
+}
+
+float UShooterMovementComponent::GetCapsuleHalfHeight() const
+{
+	return CharacterOwner ? CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.f;
+}
+
+void UShooterMovementComponent::RestoreCapsuleHalfHeight(float HalfHeight)
+{
+	if (CharacterOwner == nullptr || HalfHeight <= 0.f) return;
+
+	SetCapsuleHalfHeightKeepingMesh(HalfHeight);
+
+	// the replayed move decides again whether the capsule still has to ease
+	bCapsuleInFlight = true;
+}
+
+void UShooterMovementComponent::InterpCapsuleHalfHeight(float DeltaSeconds)
+{
+	if (CharacterOwner == nullptr) return;
+
+	// checked per move rather than on the crouch flag, so replayed and corrected moves start transitions too
+	const float TargetCapsuleHalfHeight{ bWantsToShooterCrouch ? CrouchingCapsuleHalfHeight : StandingCapsuleHalfHeight };
+	if (TargetCapsuleHalfHeight != CapsuleTargetHalfHeight)
+	{
+		CapsuleTargetHalfHeight = TargetCapsuleHalfHeight;
+		bCapsuleInFlight = true;
+	}
+
+	// once converged the capsule and mesh are left alone, sparing their transform, overlap and render updates
+	if (!bCapsuleInFlight)
+	{
+		ShooterCountComponentUpdatesAvoided(2);
+		return;
+	}
+
+	float InterpHalfHeight{ FMath::FInterpTo(GetCapsuleHalfHeight(), TargetCapsuleHalfHeight, DeltaSeconds, UShooterTuningSettings::GetTuning().CapsuleInterpSpeed) };
+	if (FMath::IsNearlyEqual(InterpHalfHeight, TargetCapsuleHalfHeight, 0.01f))
+	{
+		InterpHalfHeight = TargetCapsuleHalfHeight;
+		bCapsuleInFlight = false;
+	}
+
+	SetCapsuleHalfHeightKeepingMesh(InterpHalfHeight);
+}
+
+void UShooterMovementComponent::SetCapsuleHalfHeightKeepingMesh(float HalfHeight)
+{
+	UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
+
+	// negative value if crouching, positive value if standing
+	const float DeltaCapsuleHalfHeight{ HalfHeight - Capsule->GetScaledCapsuleHalfHeight() };
+	if (DeltaCapsuleHalfHeight == 0.f) return;
+
+	const FVector MeshOffset{ 0.f, 0.f, -DeltaCapsuleHalfHeight };
+	CharacterOwner->GetMesh()->AddLocalOffset(MeshOffset);
+
+	Capsule->SetCapsuleHalfHeight(HalfHeight);
+}
+
+void FSavedMove_Shooter::Clear()
+{
+	Super::Clear();
+
+	bSavedWantsToSprint = false;
+	bSavedWantsToShooterCrouch = false;
+	SavedCapsuleHalfHeight = 0.f;
+}
+
+uint8 FSavedMove_Shooter::GetCompressedFlags() const
+{
+	uint8 Flags = Super::GetCompressedFlags();
+	if (bSavedWantsToSprint)
+	{
+		Flags |= FLAG_WantsToSprint;
+	}
+	if (bSavedWantsToShooterCrouch)
+	{
+		Flags |= FLAG_WantsToShooterCrouch;
+	}
+	return Flags;
+}
+
+bool FSavedMove_Shooter::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	const FSavedMove_Shooter* NewShooterMove = static_cast<const FSavedMove_Shooter*>(NewMove.Get());
+	if (bSavedWantsToSprint != NewShooterMove->bSavedWantsToSprint || bSavedWantsToShooterCrouch != NewShooterMove->bSavedWantsToShooterCrouch)
+	{
+		return false;
+	}
+
+	// a combined move replays from the first move's start, which is only right if the capsule wasn't easing
+	if (SavedCapsuleHalfHeight != NewShooterMove->SavedCapsuleHalfHeight)
+	{
+		return false;
+	}
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_Shooter::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	if (const UShooterMovementComponent* ShooterMovement = Cast<UShooterMovementComponent>(C->GetCharacterMovement()))
+	{
+		bSavedWantsToSprint = ShooterMovement->WantsToSprint();
+		bSavedWantsToShooterCrouch = ShooterMovement->IsShooterCrouching();
+
+		// called before the move is performed, so this is the height the move starts from
+		SavedCapsuleHalfHeight = ShooterMovement->GetCapsuleHalfHeight();
+	}
+}
+
+void FSavedMove_Shooter::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	if (UShooterMovementComponent* ShooterMovement = Cast<UShooterMovementComponent>(C->GetCharacterMovement()))
+	{
+		ShooterMovement->SetWantsToSprint(bSavedWantsToSprint);
+		ShooterMovement->SetWantsToShooterCrouch(bSavedWantsToShooterCrouch);
+		ShooterMovement->RestoreCapsuleHalfHeight(SavedCapsuleHalfHeight);
+	}
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Shooter::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_Shooter());
+}
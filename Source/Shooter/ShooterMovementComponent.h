@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "ShooterMovementComponent.generated.h"
+
+/**
+ * Character movement with sprint and crouch carried in the saved moves' compressed flags, so the server
+ * replays them exactly as the client predicted. Speed and friction are derived from that state each move,
+ * and the capsule is resized here rather than by the character. Each saved move records the capsule height it
+ * started from, so a corrected client replays its moves with the capsule it actually had
+ */
+UCLASS()
+class SHOOTER_API UShooterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+public:
+	UShooterMovementComponent();
+
+	void SetWantsToSprint(bool bSprint) { bWantsToSprint = bSprint; }
+	void SetWantsToShooterCrouch(bool bCrouch) { bWantsToShooterCrouch = bCrouch; }
+	FORCEINLINE bool WantsToSprint() const { return bWantsToSprint; }
+	FORCEINLINE bool IsShooterCrouching() const { return bWantsToShooterCrouch; }
+
+	// current capsule half height, saved with each client move
+	float GetCapsuleHalfHeight() const;
+
+	// snaps the capsule to a saved move's starting half height before the move is replayed
+	void RestoreCapsuleHalfHeight(float HalfHeight);
+
+	// UCharacterMovementComponent interface
+	virtual float GetMaxSpeed() const override;
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+protected:
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+
+private:
+	// eases the capsule toward the crouching or standing half height, keeping the mesh on the ground
+	void InterpCapsuleHalfHeight(float DeltaSeconds);
+
+	// resizes the capsule and moves the mesh by the difference so it stays on the ground
+	void SetCapsuleHalfHeightKeepingMesh(float HalfHeight);
+
+	// half height of the capsule when not crouching
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Shooter", meta = (AllowPrivateAccess = "true"))
+	float StandingCapsuleHalfHeight;
+
+	// half height of the capsule when crouching
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Shooter", meta = (AllowPrivateAccess = "true"))
+	float CrouchingCapsuleHalfHeight;
+
+	// half height the capsule is easing toward; the capsule and mesh are only touched while bCapsuleInFlight
+	float CapsuleTargetHalfHeight;
+
+	uint8 bWantsToSprint : 1;
+	uint8 bWantsToShooterCrouch : 1;
+	uint8 bCapsuleInFlight : 1;
+};
+
+// a client move that also remembers sprint, crouch and the capsule height it started from
+class FSavedMove_Shooter : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	virtual void Clear() override;
+	virtual uint8 GetCompressedFlags() const override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual void PrepMoveFor(ACharacter* C) override;
+
+	uint8 bSavedWantsToSprint : 1;
+	uint8 bSavedWantsToShooterCrouch : 1;
+
+	// the capsule eases over several moves, so a replay has to start from the height the client had
+	float SavedCapsuleHalfHeight;
+};
+
+class FNetworkPredictionData_Client_Shooter : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	explicit FNetworkPredictionData_Client_Shooter(const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
@@ -2,25 +2,136 @@
 
 
 #include "ShooterPlayerController.h"
-#include "Blueprint/UserWidget.h"
+#include "Components/WidgetComponent.h"
+#include "PickupWidget.h"
+#include "Item.h"
+#include "ShooterCharacter.h"
 
-AShooterPlayerController::AShooterPlayerController()
+AShooterPlayerController::AShooterPlayerController() :
+	MaxPickupWidgets(2)
 {
 	
 }
 
-void AShooterPlayerController::BeginPlay()
+void AShooterPlayerController::OnPossess(APawn* InPawn)
 {
-	Super::BeginPlay();
+	Super::OnPossess(InPawn);
 
-	// check our HUDOverlayClass TSubclassOf variable
-	if (HUDOverlayClass)
+	if (AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(InPawn))
 	{
-		HUDOverlay = CreateWidget<UUserWidget>(this, HUDOverlayClass);
-		if (HUDOverlay)
+		ShooterCharacter->PushHUDState();
+	}
+}
+
+void AShooterPlayerController::SetHUDAmmo(int32 Ammo, int32 CarriedAmmo)
+{
+	if (HUDState.Ammo == Ammo && HUDState.CarriedAmmo == CarriedAmmo) return;
+
+	HUDState.Ammo = Ammo;
+	HUDState.CarriedAmmo = CarriedAmmo;
+	HUDStateChanged();
+}
+
+void AShooterPlayerController::SetHUDCrosshairSpread(float SpreadMultiplier)
+{
+	if (HUDState.CrosshairSpreadMultiplier == SpreadMultiplier) return;
+
+	HUDState.CrosshairSpreadMultiplier = SpreadMultiplier;
+	HUDStateChanged();
+}
+
+void AShooterPlayerController::SetHUDCombatState(ECombatState CombatState)
+{
+	if (HUDState.CombatState == CombatState) return;
+
+	HUDState.CombatState = CombatState;
+	HUDStateChanged();
+}
+
+void AShooterPlayerController::SetHUDAiming(bool bAiming)
+{
+	if (HUDState.bAiming == bAiming) return;
+
+	HUDState.bAiming = bAiming;
+	HUDStateChanged();
+}
+
+void AShooterPlayerController::HUDStateChanged()
+{
+	++HUDState.Version;
+	OnHUDStateChanged.Broadcast(HUDState);
+}
+
+void AShooterPlayerController::ShowPickupWidget(AItem* Item)
+{
+	if (Item == nullptr) return;
+
+	// already showing this item
+	const int32 BoundIndex = PickupWidgetItems.Find(Item);
+	if (BoundIndex != INDEX_NONE) return;
+
+	UWidgetComponent* WidgetComponent = AcquirePickupWidget();
+	if (WidgetComponent == nullptr) return;
+
+	PickupWidgetItems[PickupWidgetPool.Find(WidgetComponent)] = Item;
+
+	WidgetComponent->AttachToComponent(Item->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	WidgetComponent->SetRelativeLocation(Item->GetPickupWidgetOffset());
+
+	if (UPickupWidget* Widget = Cast<UPickupWidget>(WidgetComponent->GetUserWidgetObject()))
+	{
+		Widget->SetItem(Item);
+	}
+	WidgetComponent->SetVisibility(true);
+}
+
+void AShooterPlayerController::HidePickupWidget(AItem* Item)
+{
+	const int32 BoundIndex = PickupWidgetItems.Find(Item);
+	if (BoundIndex == INDEX_NONE) return;
+
+	UWidgetComponent* WidgetComponent = PickupWidgetPool[BoundIndex];
+	WidgetComponent->SetVisibility(false);
+	WidgetComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+
+	if (UPickupWidget* Widget = Cast<UPickupWidget>(WidgetComponent->GetUserWidgetObject()))
+	{
+		Widget->SetItem(nullptr);
+	}
+	PickupWidgetItems[BoundIndex] = nullptr;
+}
+
+UWidgetComponent* AShooterPlayerController::AcquirePickupWidget()
+{
+	// reuse a free widget first
+	const int32 FreeIndex = PickupWidgetItems.Find(nullptr);
+	if (FreeIndex != INDEX_NONE)
+	{
+		return PickupWidgetPool[FreeIndex];
+	}
+
+	if (PickupWidgetClass == nullptr || PickupWidgetPool.Num() >= MaxPickupWidgets)
+	{
+		// pool exhausted, take the first widget from its item
+		if (PickupWidgetPool.Num() > 0)
 		{
-			HUDOverlay->AddToViewport();
-			HUDOverlay->SetVisibility(ESlateVisibility::Visible);
+			HidePickupWidget(PickupWidgetItems[0]);
+			return PickupWidgetPool[0];
 		}
+		return nullptr;
 	}
+
+	// screen space widgets don't need a render target
+	UWidgetComponent* WidgetComponent = NewObject<UWidgetComponent>(this);
+	WidgetComponent->SetWidgetSpace(EWidgetSpace::Screen);
+	WidgetComponent->SetDrawAtDesiredSize(true);
+	WidgetComponent->SetWidgetClass(PickupWidgetClass);
+	WidgetComponent->SetOwnerPlayer(GetLocalPlayer());
+	WidgetComponent->SetVisibility(false);
+	WidgetComponent->RegisterComponent();
+	WidgetComponent->InitWidget();
+
+	PickupWidgetPool.Add(WidgetComponent);
+	PickupWidgetItems.Add(nullptr);
+	return WidgetComponent;
 }
\ No newline at end of file
@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "ShooterHUDState.h"
 #include "ShooterPlayerController.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHUDStateChanged, const FShooterHUDState&, HUDState);
+
 /**
  * 
  */
@@ -16,15 +19,52 @@ class SHOOTER_API AShooterPlayerController : public APlayerController
 public:
 	AShooterPlayerController();
 
+	// shows a pooled pickup widget over the item, creating the pool lazily
+	void ShowPickupWidget(class AItem* Item);
+
+	// returns the widget shown over the item to the pool
+	void HidePickupWidget(AItem* Item);
+
+	// HUD state setters; each broadcasts OnHUDStateChanged only if the value changed
+	void SetHUDAmmo(int32 Ammo, int32 CarriedAmmo);
+	void SetHUDCrosshairSpread(float SpreadMultiplier);
+	void SetHUDCombatState(ECombatState CombatState);
+	void SetHUDAiming(bool bAiming);
+
+	FORCEINLINE const FShooterHUDState& GetHUDState() const { return HUDState; }
+
+	// broadcast whenever HUDState changes; HUDState.Version increases by one per broadcast
+	UPROPERTY(BlueprintAssignable, Category = Widgets)
+	FOnHUDStateChanged OnHUDStateChanged;
+
 protected:
-	virtual void BeginPlay() override;
+	// has the possessed character fill in the HUD state
+	virtual void OnPossess(APawn* InPawn) override;
+
+	// bumps the HUD state version and notifies observers
+	void HUDStateChanged();
+
+	// returns a free pooled widget component, growing the pool up to MaxPickupWidgets
+	class UWidgetComponent* AcquirePickupWidget();
 
 private:
-	// reference to the overall HUD overlay blueprint class
+	// what the HUD shows, pushed by the character on change
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Widgets, meta = (AllowPrivateAccess = "true"))
+	FShooterHUDState HUDState;
+
+	// pickup widget blueprint class; must derive from UPickupWidget
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Widgets, meta = (AllowPrivateAccess = "true"))
-	TSubclassOf<class UUserWidget> HUDOverlayClass;
+	TSubclassOf<class UPickupWidget> PickupWidgetClass;
 
-	// variable to hold the HUD overlay widget after creating it 
+	// max number of pickup widgets shown at once
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Widgets, meta = (AllowPrivateAccess = "true"))
+	int32 MaxPickupWidgets;
+
+	// pooled widget components, bound to PickupWidgetItems at the same index
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Widgets, meta = (AllowPrivateAccess = "true"))
-	UUserWidget* HUDOverlay;
+	TArray<UWidgetComponent*> PickupWidgetPool;
+
+	// item each pooled widget is showing; null when free
+	UPROPERTY()
+	TArray<AItem*> PickupWidgetItems;
 };
@@ -0,0 +1,413 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterSaveSubsystem.h"
+#include "Shooter.h"
+#include "Item.h"
+#include "Weapon.h"
+#include "ShooterCharacter.h"
+#include "PickupPoolSubsystem.h"
+#include "Async/Async.h"
+#include "EngineUtils.h"
+#include "Engine/NetSerialization.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Checkpoint Gather"), STAT_ShooterCheckpointGather, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Checkpoint Apply"), STAT_ShooterCheckpointApply, STATGROUP_Shooter);
+
+// an item class referenced by the checkpoint; items store an index into the table
+struct FCheckpointItemClass
+{
+	FString Path;
+	bool bIsWeapon = false;
+};
+
+// a pickup lying in the world
+struct FCheckpointItem
+{
+	uint32 ClassIndex = 0;
+	EItemRarity Rarity = EItemRarity::EIR_Common;
+	EItemState State = EItemState::EIS_Pickup;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	// weapons only
+	uint32 Ammo = 0;
+};
+
+struct FShooterCheckpoint
+{
+	TArray<FCheckpointItemClass> ItemClasses;
+
+	bool bHasLoadout = false;
+	TArray<TPair<EAmmoType, uint32>> CarriedAmmo;
+
+	bool bHasWeapon = false;
+	FCheckpointItem Weapon;
+
+	TArray<FCheckpointItem> Items;
+};
+
+namespace
+{
+	constexpr uint32 CheckpointMagic = 0x56415353; // "SSAV"
+	constexpr uint32 CheckpointVersion = 1;
+
+	// bits reserved up front; a checkpoint packs to roughly 20 bytes per pickup
+	constexpr int64 InitialCheckpointBits = 8 * 128 * 1024;
+
+	// sanity limits so a corrupt file fails cleanly instead of allocating wildly
+	constexpr uint32 MaxItemClasses = 1024;
+	constexpr uint32 MaxItems = 1 << 20;
+
+	const TCHAR* DefaultSlot = TEXT("Checkpoint");
+
+	FString GetSlotPath(const FString& Slot)
+	{
+		return FPaths::ProjectSavedDir() / TEXT("SaveGames") / Slot + TEXT(".ssav");
+	}
+
+	// still lying in the world, not pooled and not held by a character
+	bool IsWorldPickup(const AItem* Item)
+	{
+		if (Item == nullptr || Item->IsPendingKill() || Item->IsPooledDormant()) return false;
+		return Item->GetItemState() == EItemState::EIS_Pickup || Item->GetItemState() == EItemState::EIS_Falling;
+	}
+
+	// enums are packed into just enough bits to hold EnumMax - 1
+	template<typename EnumType>
+	void SerializeEnum(FArchive& Ar, EnumType& Value, EnumType EnumMax)
+	{
+		uint32 Packed{ static_cast<uint32>(Value) };
+		Ar.SerializeInt(Packed, static_cast<uint32>(EnumMax));
+		Value = static_cast<EnumType>(Packed);
+	}
+
+	void SerializeFlag(FArchive& Ar, bool& bFlag)
+	{
+		uint8 Bit{ bFlag ? uint8(1) : uint8(0) };
+		Ar.SerializeBits(&Bit, 1);
+		bFlag = Bit != 0;
+	}
+
+	void SerializeItem(FArchive& Ar, FCheckpointItem& Item, const TArray<FCheckpointItemClass>& ItemClasses)
+	{
+		Ar.SerializeInt(Item.ClassIndex, FMath::Max<uint32>(ItemClasses.Num(), 2));
+		if (!ItemClasses.IsValidIndex(Item.ClassIndex))
+		{
+			Ar.SetError();
+			return;
+		}
+
+		SerializeEnum(Ar, Item.Rarity, EItemRarity::EIR_MAX);
+		SerializeEnum(Ar, Item.State, EItemState::EIS_MAX);
+
+		// locations to a tenth of a centimetre, rotations to 16 bits per axis
+		SerializePackedVector<10, 24>(Item.Location, Ar);
+		Item.Rotation.SerializeCompressedShort(Ar);
+
+		if (ItemClasses[Item.ClassIndex].bIsWeapon)
+		{
+			Ar.SerializeIntPacked(Item.Ammo);
+		}
+	}
+
+	// one function for both directions, so the reader can't drift from the writer
+	bool SerializeCheckpoint(FArchive& Ar, FShooterCheckpoint& Checkpoint)
+	{
+		uint32 Magic{ CheckpointMagic };
+		uint32 Version{ CheckpointVersion };
+		Ar << Magic << Version;
+		if (Magic != CheckpointMagic || Version > CheckpointVersion)
+		{
+			Ar.SetError();
+			return false;
+		}
+
+		uint32 NumClasses = Checkpoint.ItemClasses.Num();
+		Ar.SerializeIntPacked(NumClasses);
+		if (Ar.IsError() || NumClasses > MaxItemClasses)
+		{
+			Ar.SetError();
+			return false;
+		}
+		Checkpoint.ItemClasses.SetNum(NumClasses);
+		for (FCheckpointItemClass& ItemClass : Checkpoint.ItemClasses)
+		{
+			Ar << ItemClass.Path;
+			SerializeFlag(Ar, ItemClass.bIsWeapon);
+		}
+
+		SerializeFlag(Ar, Checkpoint.bHasLoadout);
+		if (Checkpoint.bHasLoadout)
+		{
+			uint32 NumAmmo = Checkpoint.CarriedAmmo.Num();
+			Ar.SerializeInt(NumAmmo, static_cast<uint32>(EAmmoType::EAT_MAX) + 1);
+			Checkpoint.CarriedAmmo.SetNum(NumAmmo);
+			for (TPair<EAmmoType, uint32>& Ammo : Checkpoint.CarriedAmmo)
+			{
+				SerializeEnum(Ar, Ammo.Key, EAmmoType::EAT_MAX);
+				Ar.SerializeIntPacked(Ammo.Value);
+			}
+
+			SerializeFlag(Ar, Checkpoint.bHasWeapon);
+			if (Checkpoint.bHasWeapon)
+			{
+				SerializeItem(Ar, Checkpoint.Weapon, Checkpoint.ItemClasses);
+			}
+		}
+
+		uint32 NumItems = Checkpoint.Items.Num();
+		Ar.SerializeIntPacked(NumItems);
+		if (Ar.IsError() || NumItems > MaxItems)
+		{
+			Ar.SetError();
+			return false;
+		}
+		Checkpoint.Items.SetNum(NumItems);
+		for (FCheckpointItem& Item : Checkpoint.Items)
+		{
+			SerializeItem(Ar, Item, Checkpoint.ItemClasses);
+			if (Ar.IsError()) return false;
+		}
+
+		return !Ar.IsError();
+	}
+
+	void SaveCheckpointCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		if (UShooterSaveSubsystem* Save = World ? World->GetSubsystem<UShooterSaveSubsystem>() : nullptr)
+		{
+			Save->SaveCheckpoint(Args.Num() > 0 ? Args[0] : DefaultSlot);
+		}
+	}
+
+	void LoadCheckpointCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		if (UShooterSaveSubsystem* Save = World ? World->GetSubsystem<UShooterSaveSubsystem>() : nullptr)
+		{
+			Save->LoadCheckpoint(Args.Num() > 0 ? Args[0] : DefaultSlot);
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CheckpointSaveCommand(
+		TEXT("shooter.Checkpoint.Save"),
+		TEXT("Saves the loadout and world pickups to a slot (default Checkpoint)."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SaveCheckpointCommand));
+
+	FAutoConsoleCommandWithWorldAndArgs CheckpointLoadCommand(
+		TEXT("shooter.Checkpoint.Load"),
+		TEXT("Restores the loadout and world pickups from a slot (default Checkpoint)."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&LoadCheckpointCommand));
+}
+
+void UShooterSaveSubsystem::Deinitialize()
+{
+	WaitForPendingSave();
+
+	Super::Deinitialize();
+}
+
+void UShooterSaveSubsystem::SaveCheckpoint(const FString& Slot)
+{
+	FShooterCheckpoint Checkpoint;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ShooterCheckpointGather);
+
+		TMap<UClass*, uint32> ClassIndices;
+		auto GatherItem = [&Checkpoint, &ClassIndices](const AItem* Item, FCheckpointItem& Out)
+		{
+			UClass* ItemClass = Item->GetClass();
+			if (const uint32* ClassIndex = ClassIndices.Find(ItemClass))
+			{
+				Out.ClassIndex = *ClassIndex;
+			}
+			else
+			{
+				Out.ClassIndex = Checkpoint.ItemClasses.Num();
+				ClassIndices.Add(ItemClass, Out.ClassIndex);
+
+				FCheckpointItemClass& NewClass = Checkpoint.ItemClasses.AddDefaulted_GetRef();
+				NewClass.Path = ItemClass->GetPathName();
+				NewClass.bIsWeapon = ItemClass->IsChildOf<AWeapon>();
+			}
+
+			Out.Rarity = Item->GetItemRarity();
+			Out.State = Item->GetItemState();
+			Out.Location = Item->GetActorLocation();
+			Out.Rotation = Item->GetActorRotation();
+			if (const AWeapon* Weapon = Cast<AWeapon>(Item))
+			{
+				Out.Ammo = Weapon->GetAmmo();
+			}
+		};
+
+		if (const AShooterCharacter* Character = Cast<AShooterCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0)))
+		{
+			Checkpoint.bHasLoadout = true;
+			for (const TPair<EAmmoType, int32>& Ammo : Character->GetAmmoMap())
+			{
+				Checkpoint.CarriedAmmo.Emplace(Ammo.Key, static_cast<uint32>(FMath::Max(Ammo.Value, 0)));
+			}
+
+			if (const AWeapon* Weapon = Character->GetEquippedWeapon())
+			{
+				Checkpoint.bHasWeapon = true;
+				GatherItem(Weapon, Checkpoint.Weapon);
+			}
+		}
+
+		for (TActorIterator<AItem> It(GetWorld()); It; ++It)
+		{
+			if (IsWorldPickup(*It))
+			{
+				GatherItem(*It, Checkpoint.Items.AddDefaulted_GetRef());
+			}
+		}
+	}
+
+	// one write in flight at a time, so an older checkpoint can't land on top of a newer one
+	WaitForPendingSave();
+
+	const FString Path{ GetSlotPath(Slot) };
+	PendingSave = Async(EAsyncExecution::ThreadPool, [Checkpoint = MoveTemp(Checkpoint), Path]() mutable
+	{
+		FBitWriter Writer(InitialCheckpointBits, true);
+		if (!SerializeCheckpoint(Writer, Checkpoint))
+		{
+			UE_LOG(LogShooter, Error, TEXT("Failed to pack checkpoint %s"), *Path);
+			return false;
+		}
+
+		// write beside the slot and swap it in, so a crash mid-write leaves the previous checkpoint intact
+		const FString TempPath{ Path + TEXT(".tmp") };
+		TArrayView<const uint8> Data(Writer.GetData(), static_cast<int32>(Writer.GetNumBytes()));
+		if (!FFileHelper::SaveArrayToFile(Data, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath))
+		{
+			UE_LOG(LogShooter, Error, TEXT("Failed to write checkpoint %s"), *Path);
+			return false;
+		}
+
+		UE_LOG(LogShooter, Log, TEXT("Saved checkpoint %s: %d pickups in %d bytes"), *Path, Checkpoint.Items.Num(), Data.Num());
+		return true;
+	});
+}
+
+void UShooterSaveSubsystem::LoadCheckpoint(const FString& Slot)
+{
+	// a save of the same slot may still be in flight
+	WaitForPendingSave();
+
+	const FString Path{ GetSlotPath(Slot) };
+	TWeakObjectPtr<UShooterSaveSubsystem> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [Path, WeakThis]()
+	{
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *Path))
+		{
+			UE_LOG(LogShooter, Warning, TEXT("No checkpoint at %s"), *Path);
+			return;
+		}
+
+		TSharedRef<FShooterCheckpoint, ESPMode::ThreadSafe> Checkpoint = MakeShared<FShooterCheckpoint, ESPMode::ThreadSafe>();
+		FBitReader Reader(Data.GetData(), Data.Num() * 8);
+		if (!SerializeCheckpoint(Reader, *Checkpoint))
+		{
+			UE_LOG(LogShooter, Error, TEXT("Checkpoint %s is corrupt or from a newer version"), *Path);
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Checkpoint]()
+		{
+			if (UShooterSaveSubsystem* SaveSubsystem = WeakThis.Get())
+			{
+				SaveSubsystem->ApplyCheckpoint(*Checkpoint);
+			}
+		});
+	});
+}
+
+void UShooterSaveSubsystem::ApplyCheckpoint(const FShooterCheckpoint& Checkpoint)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCheckpointApply);
+
+	UPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UPickupPoolSubsystem>();
+	if (PickupPool == nullptr) return;
+
+	// classes that no longer exist leave their items out instead of failing the whole load
+	TArray<UClass*, TInlineAllocator<16>> ItemClasses;
+	for (const FCheckpointItemClass& ItemClass : Checkpoint.ItemClasses)
+	{
+		ItemClasses.Add(FSoftClassPath(ItemClass.Path).TryLoadClass<AItem>());
+	}
+
+	// pickups in the world now make way for the checkpoint's; pooling them first means the restore below reuses them
+	TArray<AItem*> WorldPickups;
+	for (TActorIterator<AItem> It(GetWorld()); It; ++It)
+	{
+		if (IsWorldPickup(*It))
+		{
+			WorldPickups.Add(*It);
+		}
+	}
+	for (AItem* Item : WorldPickups)
+	{
+		PickupPool->ReleaseItem(Item);
+	}
+
+	auto RestoreItem = [PickupPool, &ItemClasses](const FCheckpointItem& Saved, const FTransform& Transform) -> AItem*
+	{
+		UClass* ItemClass = ItemClasses[Saved.ClassIndex];
+		AItem* Item = ItemClass ? PickupPool->AcquireItem(ItemClass, Transform) : nullptr;
+		if (Item)
+		{
+			Item->SetItemRarity(Saved.Rarity);
+			if (AWeapon* Weapon = Cast<AWeapon>(Item))
+			{
+				Weapon->SetAmmo(Saved.Ammo);
+			}
+		}
+		return Item;
+	};
+
+	// pooled items come back in the pickup state; a weapon saved mid-throw falls again from where it was,
+	// without the velocity it had, and turns back into a pickup when the throw would have ended
+	for (const FCheckpointItem& Saved : Checkpoint.Items)
+	{
+		AItem* Item = RestoreItem(Saved, FTransform(Saved.Rotation, Saved.Location));
+		AWeapon* Weapon = Cast<AWeapon>(Item);
+		if (Weapon && Saved.State == EItemState::EIS_Falling)
+		{
+			Weapon->StartFalling();
+		}
+	}
+
+	AShooterCharacter* Character = Cast<AShooterCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	if (Character && Checkpoint.bHasLoadout)
+	{
+		TMap<EAmmoType, int32> CarriedAmmo;
+		for (const TPair<EAmmoType, uint32>& Ammo : Checkpoint.CarriedAmmo)
+		{
+			CarriedAmmo.Add(Ammo.Key, static_cast<int32>(Ammo.Value));
+		}
+
+		AWeapon* Weapon = Checkpoint.bHasWeapon ? Cast<AWeapon>(RestoreItem(Checkpoint.Weapon, Character->GetActorTransform())) : nullptr;
+		Character->RestoreLoadout(CarriedAmmo, Weapon);
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Loaded checkpoint: %d pickups"), Checkpoint.Items.Num());
+}
+
+void UShooterSaveSubsystem::WaitForPendingSave()
+{
+	if (PendingSave.IsValid())
+	{
+		PendingSave.Wait();
+		PendingSave.Reset();
+	}
+}
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Async/Future.h"
+#include "ShooterSaveSubsystem.generated.h"
+
+struct FShooterCheckpoint;
+
+/**
+ * Saves and restores checkpoints: the first player's carried ammo and equipped weapon, and every pickup lying in the world.
+ * The game thread only copies state into plain structs; packing into the versioned bit stream and file IO happen on the
+ * thread pool. Loading reads and unpacks off the game thread too, then reuses pooled items for the restored pickups
+ */
+UCLASS()
+class SHOOTER_API UShooterSaveSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	// snapshots the world and writes it to Saved/SaveGames/<Slot>.ssav in the background
+	void SaveCheckpoint(const FString& Slot);
+
+	// reads the slot in the background and applies it on the game thread once it has been unpacked
+	void LoadCheckpoint(const FString& Slot);
+
+private:
+	void ApplyCheckpoint(const FShooterCheckpoint& Checkpoint);
+
+	// blocks until the last background save has hit the disk
+	void WaitForPendingSave();
+
+	TFuture<bool> PendingSave;
+};
@@ -0,0 +1,241 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterTelemetry.h"
+#include "Shooter.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Telemetry Events Dropped"), STAT_ShooterTelemetryDropped, STATGROUP_Shooter);
+
+std::atomic<bool> FShooterTelemetry::bRecording{ false };
+
+namespace
+{
+	// how often the writer wakes to drain the rings
+	constexpr uint32 DrainIntervalMs = 20;
+
+	// a new file is started once the current one reaches this size
+	constexpr int64 MaxFileBytes = 64 * 1024 * 1024;
+
+	// every thread's ring; rings live as long as the process since threads keep pointers to them
+	FCriticalSection RingsLock;
+	TArray<TUniquePtr<FShooterTelemetryRing>> Rings;
+
+	thread_local FShooterTelemetryRing* ThreadRing = nullptr;
+
+	std::atomic<uint32> DroppedEvents{ 0 };
+
+	FShooterTelemetryRing& GetThreadRing()
+	{
+		if (ThreadRing == nullptr)
+		{
+			FScopeLock Lock(&RingsLock);
+			ThreadRing = Rings.Add_GetRef(MakeUnique<FShooterTelemetryRing>()).Get();
+		}
+		return *ThreadRing;
+	}
+
+	class FShooterTelemetryWriter : public FRunnable
+	{
+	public:
+		FShooterTelemetryWriter() : WakeEvent(FPlatformProcess::GetSynchEventFromPool()) {}
+		virtual ~FShooterTelemetryWriter() override { FPlatformProcess::ReturnSynchEventToPool(WakeEvent); }
+
+		virtual uint32 Run() override
+		{
+			while (!bStopping.load(std::memory_order_acquire))
+			{
+				WakeEvent->Wait(DrainIntervalMs);
+				DrainRings();
+			}
+
+			// events recorded before Stop still make it to disk
+			DrainRings();
+			CloseFile();
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping.store(true, std::memory_order_release);
+			WakeEvent->Trigger();
+		}
+
+		int64 GetEventsWritten() const { return EventsWritten; }
+
+	private:
+		void DrainRings()
+		{
+			Batch.Reset();
+			{
+				FScopeLock Lock(&RingsLock);
+				for (const TUniquePtr<FShooterTelemetryRing>& Ring : Rings)
+				{
+					Ring->Drain(Batch);
+				}
+			}
+			if (Batch.Num() == 0) return;
+
+			if (File == nullptr)
+			{
+				OpenFile();
+				if (File == nullptr) return;
+			}
+
+			const int64 NumBytes{ Batch.Num() * static_cast<int64>(sizeof(FShooterTelemetryEvent)) };
+			File->Write(reinterpret_cast<const uint8*>(Batch.GetData()), NumBytes);
+			FileBytes += NumBytes;
+			EventsWritten += Batch.Num();
+
+			if (FileBytes >= MaxFileBytes)
+			{
+				CloseFile();
+			}
+		}
+
+		void OpenFile()
+		{
+			const FString Directory{ FPaths::ProjectSavedDir() / TEXT("Telemetry") };
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			PlatformFile.CreateDirectoryTree(*Directory);
+
+			const FString FileName{ FString::Printf(TEXT("Shooter-%s-%d.stel"), *FDateTime::Now().ToString(), FileIndex++) };
+			File.Reset(PlatformFile.OpenWrite(*(Directory / FileName)));
+			if (File == nullptr)
+			{
+				UE_LOG(LogShooter, Warning, TEXT("Telemetry could not open %s"), *FileName);
+				return;
+			}
+
+			FShooterTelemetryFileHeader Header;
+			Header.Magic = FShooterTelemetryFileHeader::ExpectedMagic;
+			Header.Version = FShooterTelemetryFileHeader::CurrentVersion;
+			Header.EventSize = sizeof(FShooterTelemetryEvent);
+			Header.SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+			Header.StartCycles = FPlatformTime::Cycles64();
+			Header.StartUnixTime = FDateTime::UtcNow().ToUnixTimestamp();
+			File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+			FileBytes = sizeof(Header);
+		}
+
+		void CloseFile()
+		{
+			File.Reset();
+			FileBytes = 0;
+		}
+
+		FEvent* WakeEvent;
+		std::atomic<bool> bStopping{ false };
+
+		TUniquePtr<IFileHandle> File;
+		int64 FileBytes = 0;
+		int32 FileIndex = 0;
+		int64 EventsWritten = 0;
+
+		// reused between drains
+		TArray<FShooterTelemetryEvent> Batch;
+	};
+
+	TUniquePtr<FShooterTelemetryWriter> Writer;
+	TUniquePtr<FRunnableThread> WriterThread;
+
+	// Start calls not yet matched by Stop; every PIE instance has its own game instance and so its own Start
+	int32 StartCount = 0;
+
+	// the cost per event the recording path is meant to stay under
+	constexpr double BenchmarkBudgetNanoseconds = 50.0;
+
+	// records events into a private ring and reports the cost per event; draining is left out of the timing
+	void RunTelemetryBenchmark(const TArray<FString>& Args)
+	{
+		const int32 NumEvents{ Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1'000'000 };
+		TUniquePtr<FShooterTelemetryRing> Ring = MakeUnique<FShooterTelemetryRing>();
+		TArray<FShooterTelemetryEvent> Drained;
+		Drained.Reserve(FShooterTelemetryRing::Capacity);
+
+		FShooterTelemetryEvent Event{};
+		Event.Type = EShooterTelemetryEventType::ShotFired;
+		uint64 TimedCycles{ 0 };
+		for (int32 Recorded = 0; Recorded < NumEvents; )
+		{
+			const int32 Chunk{ FMath::Min<int32>(FShooterTelemetryRing::Capacity, NumEvents - Recorded) };
+			const uint64 ChunkStart{ FPlatformTime::Cycles64() };
+			for (int32 i = 0; i < Chunk; i++)
+			{
+				Event.Cycles = FPlatformTime::Cycles64();
+				Event.Count = static_cast<uint16>(i);
+				Ring->Push(Event);
+			}
+			TimedCycles += FPlatformTime::Cycles64() - ChunkStart;
+			Recorded += Chunk;
+
+			Drained.Reset();
+			Ring->Drain(Drained);
+		}
+
+		const double NanosecondsPerEvent{ FPlatformTime::ToSeconds64(TimedCycles) * 1e9 / NumEvents };
+		if (NanosecondsPerEvent > BenchmarkBudgetNanoseconds)
+		{
+			UE_LOG(LogShooter, Warning, TEXT("Telemetry benchmark: %d events, %.1f ns per event, over the %.0f ns budget"), NumEvents, NanosecondsPerEvent, BenchmarkBudgetNanoseconds);
+		}
+		else
+		{
+			UE_LOG(LogShooter, Display, TEXT("Telemetry benchmark: %d events, %.1f ns per event"), NumEvents, NanosecondsPerEvent);
+		}
+	}
+
+	FAutoConsoleCommand TelemetryBenchmarkCommand(
+		TEXT("shooter.Telemetry.Benchmark"),
+		TEXT("Records N telemetry events (default 1000000) and logs the cost per event."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunTelemetryBenchmark));
+}
+
+int32 FShooterTelemetryRing::Drain(TArray<FShooterTelemetryEvent>& Out)
+{
+	const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+	const uint32 CurrentHead = Head.load(std::memory_order_acquire);
+	for (uint32 Index = CurrentTail; Index != CurrentHead; Index++)
+	{
+		Out.Add(Events[Index & (Capacity - 1)]);
+	}
+	Tail.store(CurrentHead, std::memory_order_release);
+	return static_cast<int32>(CurrentHead - CurrentTail);
+}
+
+void FShooterTelemetry::Start()
+{
+	check(IsInGameThread());
+	if (StartCount++ > 0) return;
+
+	Writer = MakeUnique<FShooterTelemetryWriter>();
+	WriterThread.Reset(FRunnableThread::Create(Writer.Get(), TEXT("ShooterTelemetryWriter"), 0, TPri_BelowNormal));
+	bRecording.store(true, std::memory_order_relaxed);
+}
+
+void FShooterTelemetry::Stop()
+{
+	check(IsInGameThread());
+	if (StartCount == 0 || --StartCount > 0) return;
+
+	bRecording.store(false, std::memory_order_relaxed);
+	// Kill stops the writer, which drains what is left before its thread returns
+	WriterThread->Kill(true);
+	WriterThread.Reset();
+
+	UE_LOG(LogShooter, Log, TEXT("Telemetry wrote %lld events, dropped %u"), Writer->GetEventsWritten(), DroppedEvents.load());
+	Writer.Reset();
+}
+
+void FShooterTelemetry::Push(const FShooterTelemetryEvent& Event)
+{
+	if (!GetThreadRing().Push(Event))
+	{
+		DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+		INC_DWORD_STAT(STAT_ShooterTelemetryDropped);
+	}
+}
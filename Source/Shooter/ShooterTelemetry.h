@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+enum class EShooterTelemetryEventType : uint8
+{
+	ShotFired,
+	Hit,
+	Reload,
+	Pickup,
+	WeaponSwap,
+
+	MAX
+};
+
+// one fixed size telemetry record, written to disk as is
+struct FShooterTelemetryEvent
+{
+	// FPlatformTime::Cycles64() when recorded
+	uint64 Cycles;
+	// GetUniqueID() of the actor the event is about
+	uint32 ActorId;
+	EShooterTelemetryEventType Type;
+	// EWeaponType, or 0xFF when no weapon is involved
+	uint8 WeaponType;
+	// shots in the batch, rounds reloaded, ...
+	uint16 Count;
+	float X;
+	float Y;
+	float Z;
+	// damage for hits, unused otherwise
+	float Value;
+};
+static_assert(sizeof(FShooterTelemetryEvent) == 32, "FShooterTelemetryEvent is written to disk as is");
+
+// start of every telemetry file
+struct FShooterTelemetryFileHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x4C455453; // "STEL"
+	static constexpr uint16 CurrentVersion = 1;
+
+	uint32 Magic;
+	uint16 Version;
+	uint16 EventSize;
+	// converts event Cycles to seconds
+	double SecondsPerCycle;
+	// Cycles64 and UTC unix time when the file was opened
+	uint64 StartCycles;
+	int64 StartUnixTime;
+};
+static_assert(sizeof(FShooterTelemetryFileHeader) == 32, "FShooterTelemetryFileHeader is written to disk as is");
+
+// single producer single consumer ring; each recording thread owns one and the writer thread drains it
+struct FShooterTelemetryRing
+{
+	static constexpr uint32 Capacity = 4096;
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	// false when the ring is full and the event was dropped
+	FORCEINLINE bool Push(const FShooterTelemetryEvent& Event)
+	{
+		const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+		if (CurrentHead - Tail.load(std::memory_order_acquire) >= Capacity)
+		{
+			return false;
+		}
+		Events[CurrentHead & (Capacity - 1)] = Event;
+		Head.store(CurrentHead + 1, std::memory_order_release);
+		return true;
+	}
+
+	// appends every available event to Out; only called by the consumer
+	int32 Drain(TArray<FShooterTelemetryEvent>& Out);
+
+	FShooterTelemetryEvent Events[Capacity];
+	std::atomic<uint32> Head{ 0 };
+	std::atomic<uint32> Tail{ 0 };
+};
+
+/**
+ * Low overhead record of combat events. Recording copies a 32 byte event into the calling thread's ring;
+ * a background thread drains the rings into rotating binary files under Saved/Telemetry, which the
+ * ShooterTelemetryCsv commandlet converts to CSV
+ */
+class SHOOTER_API FShooterTelemetry
+{
+public:
+	// starts the writer thread; events are dropped until this is called. Calls nest, so each Start needs its own Stop
+	static void Start();
+
+	// stops the writer thread after writing every event recorded so far, once every Start has been matched
+	static void Stop();
+
+	FORCEINLINE static bool IsRecording() { return bRecording.load(std::memory_order_relaxed); }
+
+	FORCEINLINE static void Record(EShooterTelemetryEventType Type, uint32 ActorId, const FVector& Location, uint8 WeaponType = 0xFF, uint16 Count = 1, float Value = 0.f)
+	{
+		if (!IsRecording()) return;
+
+		FShooterTelemetryEvent Event;
+		Event.Cycles = FPlatformTime::Cycles64();
+		Event.ActorId = ActorId;
+		Event.Type = Type;
+		Event.WeaponType = WeaponType;
+		Event.Count = Count;
+		Event.X = Location.X;
+		Event.Y = Location.Y;
+		Event.Z = Location.Z;
+		Event.Value = Value;
+		Push(Event);
+	}
+
+private:
+	static void Push(const FShooterTelemetryEvent& Event);
+
+	static std::atomic<bool> bRecording;
+};
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterTelemetryCsvCommandlet.h"
+#include "Shooter.h"
+#include "ShooterTelemetry.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// indexed by EShooterTelemetryEventType
+	const TCHAR* const EventTypeNames[] =
+	{
+		TEXT("ShotFired"),
+		TEXT("Hit"),
+		TEXT("Reload"),
+		TEXT("Pickup"),
+		TEXT("WeaponSwap"),
+	};
+	static_assert(UE_ARRAY_COUNT(EventTypeNames) == static_cast<int32>(EShooterTelemetryEventType::MAX), "EventTypeNames needs an entry per EShooterTelemetryEventType");
+}
+
+UShooterTelemetryCsvCommandlet::UShooterTelemetryCsvCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UShooterTelemetryCsvCommandlet::Main(const FString& Params)
+{
+	FString InPath;
+	if (!FParse::Value(*Params, TEXT("In="), InPath))
+	{
+		UE_LOG(LogShooter, Error, TEXT("Usage: -run=ShooterTelemetryCsv -In=<file.stel> [-Out=<file.csv>]"));
+		return 1;
+	}
+	FString OutPath;
+	if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+	{
+		OutPath = FPaths::ChangeExtension(InPath, TEXT("csv"));
+	}
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InPath))
+	{
+		UE_LOG(LogShooter, Error, TEXT("Could not read %s"), *InPath);
+		return 1;
+	}
+
+	FShooterTelemetryFileHeader Header;
+	if (Bytes.Num() < sizeof(Header))
+	{
+		UE_LOG(LogShooter, Error, TEXT("%s is too short to be a telemetry file"), *InPath);
+		return 1;
+	}
+	FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+	if (Header.Magic != FShooterTelemetryFileHeader::ExpectedMagic || Header.Version != FShooterTelemetryFileHeader::CurrentVersion || Header.EventSize != sizeof(FShooterTelemetryEvent))
+	{
+		UE_LOG(LogShooter, Error, TEXT("%s is not a version %d telemetry file"), *InPath, FShooterTelemetryFileHeader::CurrentVersion);
+		return 1;
+	}
+
+	// a file cut short by a crash ends in a partial event, which is skipped
+	const int32 NumEvents{ static_cast<int32>((Bytes.Num() - sizeof(Header)) / sizeof(FShooterTelemetryEvent)) };
+	TArray<FShooterTelemetryEvent> Events;
+	Events.SetNumUninitialized(NumEvents);
+	FMemory::Memcpy(Events.GetData(), Bytes.GetData() + sizeof(Header), NumEvents * sizeof(FShooterTelemetryEvent));
+
+	// each thread's ring is drained separately, so events are only ordered per thread on disk
+	Events.Sort([](const FShooterTelemetryEvent& A, const FShooterTelemetryEvent& B) { return A.Cycles < B.Cycles; });
+
+	FString Csv{ TEXT("Seconds,Type,ActorId,WeaponType,Count,X,Y,Z,Value\n") };
+	Csv.Reserve(Csv.Len() + NumEvents * 64);
+	for (const FShooterTelemetryEvent& Event : Events)
+	{
+		const double Seconds{ (static_cast<int64>(Event.Cycles) - static_cast<int64>(Header.StartCycles)) * Header.SecondsPerCycle };
+		const int32 TypeIndex{ static_cast<int32>(Event.Type) };
+		Csv += FString::Printf(TEXT("%.6f,%s,%u,%d,%u,%.1f,%.1f,%.1f,%.2f\n"),
+			Seconds,
+			TypeIndex < UE_ARRAY_COUNT(EventTypeNames) ? EventTypeNames[TypeIndex] : TEXT("Unknown"),
+			Event.ActorId,
+			Event.WeaponType == 0xFF ? -1 : static_cast<int32>(Event.WeaponType),
+			static_cast<uint32>(Event.Count),
+			Event.X, Event.Y, Event.Z,
+			Event.Value);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+	{
+		UE_LOG(LogShooter, Error, TEXT("Could not write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogShooter, Display, TEXT("Wrote %d events to %s"), NumEvents, *OutPath);
+	return 0;
+}
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ShooterTelemetryCsvCommandlet.generated.h"
+
+/**
+ * Converts telemetry files to CSV, one row per event in time order:
+ *   UE4Editor-Cmd Shooter.uproject -run=ShooterTelemetryCsv -In=<file.stel> [-Out=<file.csv>]
+ */
+UCLASS()
+class UShooterTelemetryCsvCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UShooterTelemetryCsvCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
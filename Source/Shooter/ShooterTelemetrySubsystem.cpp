@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterTelemetrySubsystem.h"
+#include "ShooterTelemetry.h"
+#include "Misc/CommandLine.h"
+
+void UShooterTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("ShooterTelemetry")))
+	{
+		FShooterTelemetry::Start();
+		bStartedTelemetry = true;
+	}
+}
+
+void UShooterTelemetrySubsystem::Deinitialize()
+{
+	// other PIE instances may still be recording; the last one to stop ends the file
+	if (bStartedTelemetry)
+	{
+		FShooterTelemetry::Stop();
+		bStartedTelemetry = false;
+	}
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ShooterTelemetrySubsystem.generated.h"
+
+/**
+ * Runs FShooterTelemetry for the lifetime of the game instance when the game is started with -ShooterTelemetry
+ */
+UCLASS()
+class SHOOTER_API UShooterTelemetrySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	// whether this instance holds one of FShooterTelemetry's starts
+	bool bStartedTelemetry = false;
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterTuningSettings.h"
+#include "Shooter.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Engine/World.h"
+
+namespace
+{
+	void ReloadTuningCommand(UWorld* World)
+	{
+		// movement prediction reads the tuning, so a server and its clients in separate processes would disagree;
+		// every PIE instance shares the editor's class default object and so stays in step
+		if (!GIsEditor && World && World->GetNetMode() != NM_Standalone)
+		{
+			UE_LOG(LogShooter, Warning, TEXT("shooter.Tuning.Reload only runs in standalone games and the editor; a networked game would predict with different tuning on each side"));
+			return;
+		}
+
+		UShooterTuningSettings::ReloadTuning();
+	}
+
+	FAutoConsoleCommandWithWorld TuningReloadCommand(
+		TEXT("shooter.Tuning.Reload"),
+		TEXT("Re-reads the Shooter Tuning section of the game ini from disk; running characters pick it up on the next frame. Standalone games and the editor only."),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&ReloadTuningCommand));
+}
+
+void UShooterTuningSettings::ReloadTuning()
+{
+	UShooterTuningSettings* Settings = GetMutableDefault<UShooterTuningSettings>();
+	const FString SectionName{ Settings->GetClass()->GetPathName() };
+
+	// read the game ini hierarchy from disk into a scratch file, so the cache itself is never rebuilt
+	FConfigFile DiskGameIni;
+	FConfigCacheIni::LoadLocalIniFile(DiskGameIni, TEXT("Game"), true, nullptr, true);
+#if ALLOW_INI_OVERRIDE_FROM_COMMANDLINE
+	FConfigFile::OverrideFromCommandline(&DiskGameIni, GGameIni);
+#endif
+
+	// swap in only our section; every other section, and whatever was set at runtime there, stays as it was
+	FConfigFile* CachedGameIni = GConfig->FindConfigFile(GGameIni);
+	const FConfigSection* DiskSection = DiskGameIni.Find(SectionName);
+	if (CachedGameIni && DiskSection)
+	{
+		CachedGameIni->Add(SectionName, *DiskSection);
+	}
+
+	Settings->ReloadConfig();
+
+	UE_LOG(LogShooter, Display, TEXT("Reloaded shooter tuning from [%s] in %s"), *SectionName, *GGameIni);
+}
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "ShooterTuningSettings.generated.h"
+
+// balance values shared by every character; read in place, never copied per instance
+USTRUCT(BlueprintType)
+struct FShooterTuning
+{
+	GENERATED_BODY()
+
+	// gamepad/keyboard turn and look up rates in deg/sec
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	float HipTurnRate = 90.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	float HipLookUpRate = 90.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	float AimingTurnRate = 20.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	float AimingLookUpRate = 20.f;
+
+	// mouse look sensitivity scale factors
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
+	float MouseHipTurnRate = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
+	float MouseHipLookUpRate = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
+	float MouseAimingTurnRate = 0.2f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
+	float MouseAimingLookUpRate = 0.2f;
+
+	// field of view while aiming; the default FOV comes from the camera
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	float CameraZoomedFOV = 35.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	float ZoomInterpSpeed = 20.f;
+
+	// ground speed at which the velocity part of the crosshair spread reaches 1
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crosshairs)
+	float SpreadWalkSpeed = 600.f;
+
+	// spread added while in the air, and how fast it grows in the air and shrinks after landing
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crosshairs)
+	float InAirSpread = 2.25f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crosshairs)
+	float InAirSpreadSpeed = 2.25f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crosshairs)
+	float LandedSpreadSpeed = 30.f;
+
+	// spread removed while aiming
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crosshairs)
+	float AimSpread = 0.6f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crosshairs)
+	float AimSpreadSpeed = 30.f;
+
+	// spread added just after each shot
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crosshairs)
+	float ShootingSpread = 0.3f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crosshairs)
+	float ShootingSpreadSpeed = 60.f;
+
+	// speed while standing and not sprinting
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+	float BaseMovementSpeed = 650.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+	float SprintSpeed = 1'200.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+	float CrouchMovementSpeed = 350.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+	float BaseGroundFriction = 2.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+	float CrouchingGroundFriction = 100.f;
+
+	// how fast the capsule eases between standing and crouching heights
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+	float CapsuleInterpSpeed = 20.f;
+};
+
+/**
+ * Project settings page for FShooterTuning, stored in DefaultGame.ini. Characters and their movement read
+ * the class default object's copy directly, so edits in the editor and shooter.Tuning.Reload apply on the next frame
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Shooter Tuning"))
+class SHOOTER_API UShooterTuningSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+public:
+	static FORCEINLINE const FShooterTuning& GetTuning() { return GetDefault<UShooterTuningSettings>()->Tuning; }
+
+	// re-reads this class's section of the game ini hierarchy from disk and applies it to the tuning.
+	// Only this process sees the change, so it is for standalone games and PIE; shooter.Tuning.Reload refuses networked games
+	static void ReloadTuning();
+
+private:
+	UPROPERTY(Config, EditAnywhere, Category = Tuning, meta = (ShowOnlyInnerProperties))
+	FShooterTuning Tuning;
+};
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShotSpread.h"
+
+namespace
+{
+	constexpr int32 RecoilPatternLength = 8;
+
+	// spread half angle in degrees per unit of crosshair spread multiplier, indexed by EWeaponType
+	constexpr float SpreadDegreesPerMultiplier[] =
+	{
+		// SubmachineGun
+		1.5f,
+		// AssaultRifle
+		1.f,
+		// Shotgun: pellets spread even when aiming
+		8.f,
+	};
+	static_assert(UE_ARRAY_COUNT(SpreadDegreesPerMultiplier) == static_cast<int32>(EWeaponType::EWT_MAX), "SpreadDegreesPerMultiplier needs an entry per EWeaponType");
+
+	// { pitch, yaw } kick in degrees per shot, indexed by EWeaponType
+	constexpr float RecoilPatterns[][RecoilPatternLength][2] =
+	{
+		// SubmachineGun: light, wandering
+		{ { 0.3f, 0.05f }, { 0.35f, -0.1f }, { 0.35f, 0.15f }, { 0.3f, -0.15f }, { 0.3f, 0.1f }, { 0.25f, -0.1f }, { 0.25f, 0.1f }, { 0.25f, -0.05f } },
+		// AssaultRifle: climbs, then pulls right
+		{ { 0.5f, 0.f }, { 0.6f, 0.05f }, { 0.6f, 0.1f }, { 0.5f, 0.15f }, { 0.4f, 0.2f }, { 0.35f, 0.2f }, { 0.3f, 0.15f }, { 0.3f, 0.1f } },
+		// Shotgun: one heavy kick per shell
+		{ { 2.5f, 0.2f }, { 2.5f, -0.2f }, { 2.5f, 0.2f }, { 2.5f, -0.2f }, { 2.5f, 0.2f }, { 2.5f, -0.2f }, { 2.5f, 0.2f }, { 2.5f, -0.2f } },
+	};
+	static_assert(UE_ARRAY_COUNT(RecoilPatterns) == static_cast<int32>(EWeaponType::EWT_MAX), "RecoilPatterns needs an entry per EWeaponType");
+
+	FORCEINLINE int32 WeaponTypeIndex(EWeaponType WeaponType)
+	{
+		return FMath::Clamp(static_cast<int32>(WeaponType), 0, static_cast<int32>(EWeaponType::EWT_MAX) - 1);
+	}
+}
+
+float FShotSpread::GetSpreadHalfAngle(EWeaponType WeaponType, float SpreadMultiplier)
+{
+	return FMath::DegreesToRadians(SpreadDegreesPerMultiplier[WeaponTypeIndex(WeaponType)] * FMath::Max(SpreadMultiplier, 0.f));
+}
+
+FVector FShotSpread::SampleCone(const FVector& AimDirection, float HalfAngle, FShotRandom& Random)
+{
+	FVector Direction;
+	SampleConeBatch(AimDirection, HalfAngle, Random, TArrayView<FVector>(&Direction, 1));
+	return Direction;
+}
+
+void FShotSpread::SampleConeBatch(const FVector& AimDirection, float HalfAngle, FShotRandom& Random, TArrayView<FVector> OutDirections)
+{
+	const int32 NumDirections = OutDirections.Num();
+	const FVector Forward{ AimDirection.GetSafeNormal() };
+
+	if (HalfAngle <= 0.f)
+	{
+		for (FVector& Direction : OutDirections)
+		{
+			Direction = Forward;
+		}
+		return;
+	}
+
+	FVector Right;
+	FVector Up;
+	Forward.FindBestAxisVectors(Right, Up);
+	const float DiscRadius{ FMath::Tan(FMath::Min(HalfAngle, HALF_PI - KINDA_SMALL_NUMBER)) };
+
+	// draw all random numbers first so the loop below has no dependency between pellets
+	TArray<float, TInlineAllocator<16>> Radii;
+	TArray<float, TInlineAllocator<16>> Angles;
+	Radii.SetNumUninitialized(NumDirections);
+	Angles.SetNumUninitialized(NumDirections);
+	for (int32 i = 0; i < NumDirections; i++)
+	{
+		// sqrt gives a uniform distribution over the disc
+		Radii[i] = FMath::Sqrt(Random.NextUnit()) * DiscRadius;
+		Angles[i] = Random.NextUnit() * 2.f * PI;
+	}
+
+	for (int32 i = 0; i < NumDirections; i++)
+	{
+		float Sin;
+		float Cos;
+		FMath::SinCos(&Sin, &Cos, Angles[i]);
+		OutDirections[i] = (Forward + Right * (Cos * Radii[i]) + Up * (Sin * Radii[i])).GetUnsafeNormal();
+	}
+}
+
+FVector2D FShotSpread::GetRecoilKick(EWeaponType WeaponType, int32 ShotIndex)
+{
+	const float(&Kick)[2] = RecoilPatterns[WeaponTypeIndex(WeaponType)][FMath::Clamp(ShotIndex, 0, RecoilPatternLength - 1)];
+	return FVector2D(Kick[0], Kick[1]);
+}
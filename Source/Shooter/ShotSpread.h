@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponType.h"
+
+// small seeded xorshift generator; cheap enough to run per pellet
+struct SHOOTER_API FShotRandom
+{
+	explicit FShotRandom(uint32 Seed = 0x9E3779B9u) : State(Seed != 0 ? Seed : 0x9E3779B9u) {}
+
+	FORCEINLINE uint32 NextUInt()
+	{
+		State ^= State << 13;
+		State ^= State >> 17;
+		State ^= State << 5;
+		return State;
+	}
+
+	// uniform in [0, 1)
+	FORCEINLINE float NextUnit()
+	{
+		return (NextUInt() >> 8) * (1.f / 16777216.f);
+	}
+
+	uint32 State;
+};
+
+/**
+ * Shot spread and recoil shared by every weapon. Spread is a cone around the aim direction whose
+ * half angle scales with the crosshair spread multiplier; recoil follows a fixed pattern per EWeaponType.
+ */
+struct SHOOTER_API FShotSpread
+{
+	// cone half angle in radians for a weapon at the given crosshair spread multiplier
+	static float GetSpreadHalfAngle(EWeaponType WeaponType, float SpreadMultiplier);
+
+	// one direction inside the cone around AimDirection
+	static FVector SampleCone(const FVector& AimDirection, float HalfAngle, FShotRandom& Random);
+
+	// fills OutDirections with directions inside the cone; the basis is built once for the whole batch
+	static void SampleConeBatch(const FVector& AimDirection, float HalfAngle, FShotRandom& Random, TArrayView<FVector> OutDirections);
+
+	// pitch (X) and yaw (Y) kick in degrees for the ShotIndex'th shot of a burst; the pattern holds its last entry
+	static FVector2D GetRecoilKick(EWeaponType WeaponType, int32 ShotIndex);
+};
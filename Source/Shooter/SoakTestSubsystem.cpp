@@ -0,0 +1,339 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SoakTestSubsystem.h"
+#include "Shooter.h"
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	// memory and object counts settle after this much game time; the baseline is taken then
+	constexpr float WarmupTime = 30.f;
+	constexpr float SampleInterval = 60.f;
+
+	// budgets a run has to stay inside to pass
+	constexpr double MaxMemoryGrowthMB = 64.0;
+	constexpr int32 MaxObjectGrowthPerClass = 256;
+	constexpr float MaxGCPauseP99Ms = 30.f;
+
+	// scripted players hold each action for a random time in this range
+	constexpr float MinBotActionTime = 0.5f;
+	constexpr float MaxBotActionTime = 2.f;
+
+	constexpr float DefaultSoakDuration = 3'600.f;
+
+	void StartSoakCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		USoakTestSubsystem* Soak = World ? World->GetSubsystem<USoakTestSubsystem>() : nullptr;
+		if (Soak == nullptr) return;
+
+		const float Duration{ Args.Num() > 0 ? FCString::Atof(*Args[0]) : DefaultSoakDuration };
+		Soak->StartSoak(Duration > 0.f ? Duration : DefaultSoakDuration);
+	}
+
+	void StopSoakCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		if (USoakTestSubsystem* Soak = World ? World->GetSubsystem<USoakTestSubsystem>() : nullptr)
+		{
+			Soak->StopSoak();
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs SoakStartCommand(
+		TEXT("shooter.Soak.Start"),
+		TEXT("Drives the local players with scripted input for N seconds of game time (default 3600) and checks for leaks."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StartSoakCommand));
+
+	FAutoConsoleCommandWithWorldAndArgs SoakStopCommand(
+		TEXT("shooter.Soak.Stop"),
+		TEXT("Ends the running soak test and reports the result."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StopSoakCommand));
+}
+
+void USoakTestSubsystem::StartSoak(float Duration)
+{
+	if (bSoaking || bAwaitingFinalGC) return;
+
+	bSoaking = true;
+	bHasResult = false;
+	bLastRunPassed = false;
+	RemainingTime = Duration;
+	SampleCountdown = WarmupTime;
+	BotActionCountdown = 0.f;
+
+	bHasBaseline = false;
+	BaselineObjectCounts.Reset();
+	PeakUsedPhysical = 0;
+	NumSamples = 0;
+	GCPauses.Reset();
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &USoakTestSubsystem::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &USoakTestSubsystem::OnPostGarbageCollect);
+
+	UE_LOG(LogShooter, Display, TEXT("Soak test started: %.0f seconds of game time"), Duration);
+}
+
+void USoakTestSubsystem::StopSoak()
+{
+	if (!bSoaking) return;
+
+	bSoaking = false;
+	ReleaseBotKeys();
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	if (!bHasBaseline)
+	{
+		UE_LOG(LogShooter, Error, TEXT("Soak test ended before the warm-up finished; nothing to compare"));
+		ReportResult(false);
+		return;
+	}
+
+	// collect everything the run let go of, so only what is still referenced counts as growth;
+	// requested rather than run here because this is usually called from inside the world's tick
+	bAwaitingFinalGC = true;
+	bFinalGCDone = false;
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &USoakTestSubsystem::OnFinalGarbageCollect);
+	GEngine->ForceGarbageCollection(true);
+}
+
+void USoakTestSubsystem::FinishSoak()
+{
+	bAwaitingFinalGC = false;
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	TakeSample();
+	bool bPassed{ true };
+
+	const uint64 UsedPhysical{ FPlatformMemory::GetStats().UsedPhysical };
+	const double MemoryGrowthMB{ (static_cast<double>(UsedPhysical) - static_cast<double>(BaselineUsedPhysical)) / (1024.0 * 1024.0) };
+	UE_LOG(LogShooter, Display, TEXT("Soak memory: %.1f MB growth (budget %.1f MB), peak %.1f MB, %d samples"),
+		MemoryGrowthMB, MaxMemoryGrowthMB, PeakUsedPhysical / (1024.0 * 1024.0), NumSamples);
+	if (MemoryGrowthMB > MaxMemoryGrowthMB)
+	{
+		bPassed = false;
+	}
+
+	TMap<FName, int32> ObjectCounts;
+	CountObjectsByClass(ObjectCounts);
+	for (const TPair<FName, int32>& ObjectCount : ObjectCounts)
+	{
+		const int32 Growth{ ObjectCount.Value - BaselineObjectCounts.FindRef(ObjectCount.Key) };
+		if (Growth > MaxObjectGrowthPerClass)
+		{
+			UE_LOG(LogShooter, Error, TEXT("Soak objects: %s grew by %d (budget %d)"),
+				*ObjectCount.Key.ToString(), Growth, MaxObjectGrowthPerClass);
+			bPassed = false;
+		}
+	}
+
+	float GCPauseP99{ 0.f };
+	if (GCPauses.Num() > 0)
+	{
+		GCPauses.Sort();
+		GCPauseP99 = GCPauses[FMath::Clamp(FMath::CeilToInt(GCPauses.Num() * 0.99f) - 1, 0, GCPauses.Num() - 1)];
+	}
+	UE_LOG(LogShooter, Display, TEXT("Soak GC: %d collections, p99 pause %.2f ms (budget %.2f ms)"),
+		GCPauses.Num(), GCPauseP99, MaxGCPauseP99Ms);
+	if (GCPauseP99 > MaxGCPauseP99Ms)
+	{
+		bPassed = false;
+	}
+
+	ReportResult(bPassed);
+}
+
+void USoakTestSubsystem::ReportResult(bool bPassed)
+{
+	bHasResult = true;
+	bLastRunPassed = bPassed;
+
+	if (bPassed)
+	{
+		UE_LOG(LogShooter, Display, TEXT("Soak test PASSED"));
+	}
+	else
+	{
+		UE_LOG(LogShooter, Error, TEXT("Soak test FAILED"));
+	}
+}
+
+void USoakTestSubsystem::Deinitialize()
+{
+	// the world is going away mid-run; no point collecting garbage or judging a partial run
+	if (bSoaking || bAwaitingFinalGC)
+	{
+		bSoaking = false;
+		bAwaitingFinalGC = false;
+		HeldKeys.Reset();
+		FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+		UE_LOG(LogShooter, Error, TEXT("Soak test: the world was torn down before the run finished"));
+		ReportResult(false);
+	}
+
+	Super::Deinitialize();
+}
+
+void USoakTestSubsystem::Tick(float DeltaTime)
+{
+	// judged on the first tick after the requested collection, outside of garbage collection itself
+	if (bAwaitingFinalGC)
+	{
+		if (bFinalGCDone)
+		{
+			FinishSoak();
+		}
+		return;
+	}
+
+	DriveBots(DeltaTime);
+
+	SampleCountdown -= DeltaTime;
+	if (SampleCountdown <= 0.f)
+	{
+		SampleCountdown = SampleInterval;
+		TakeSample();
+	}
+
+	RemainingTime -= DeltaTime;
+	if (RemainingTime <= 0.f)
+	{
+		StopSoak();
+	}
+}
+
+ETickableTickType USoakTestSubsystem::GetTickableTickType() const
+{
+	// the class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId USoakTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USoakTestSubsystem, STATGROUP_Tickables);
+}
+
+void USoakTestSubsystem::DriveBots(float DeltaTime)
+{
+	BotActionCountdown -= DeltaTime;
+	if (BotActionCountdown > 0.f) return;
+	BotActionCountdown = FMath::FRandRange(MinBotActionTime, MaxBotActionTime);
+
+	ReleaseBotKeys();
+
+	// always on the move, strafing and turning now and then so pickups keep coming under the crosshair
+	HeldKeys.Add(EKeys::W);
+	const int32 Strafe{ FMath::RandRange(0, 2) };
+	if (Strafe == 1) HeldKeys.Add(EKeys::A);
+	if (Strafe == 2) HeldKeys.Add(EKeys::D);
+	if (FMath::RandBool()) HeldKeys.Add(EKeys::Right);
+
+	// held actions last until the next pick; the rest are tapped once
+	TArray<FKey, TInlineAllocator<2>> TappedKeys;
+	switch (FMath::RandRange(0, 6))
+	{
+	case 0:
+		HeldKeys.Add(EKeys::LeftMouseButton);
+		break;
+	case 1:
+		HeldKeys.Add(EKeys::RightMouseButton);
+		HeldKeys.Add(EKeys::LeftMouseButton);
+		break;
+	case 2:
+		HeldKeys.Add(EKeys::LeftShift);
+		break;
+	case 3:
+		TappedKeys.Add(EKeys::R);
+		break;
+	case 4:
+		TappedKeys.Add(EKeys::C);
+		break;
+	case 5:
+		// picks up whatever is traced, swapping out (and dropping) the equipped weapon
+		TappedKeys.Add(EKeys::E);
+		break;
+	case 6:
+		TappedKeys.Add(EKeys::SpaceBar);
+		break;
+	}
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		if (PlayerController == nullptr || !PlayerController->IsLocalController()) continue;
+
+		for (const FKey& Key : HeldKeys)
+		{
+			PlayerController->InputKey(Key, IE_Pressed, 1.f, false);
+		}
+		for (const FKey& Key : TappedKeys)
+		{
+			PlayerController->InputKey(Key, IE_Pressed, 1.f, false);
+			PlayerController->InputKey(Key, IE_Released, 0.f, false);
+		}
+	}
+}
+
+void USoakTestSubsystem::ReleaseBotKeys()
+{
+	if (HeldKeys.Num() == 0) return;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		if (PlayerController == nullptr || !PlayerController->IsLocalController()) continue;
+
+		for (const FKey& Key : HeldKeys)
+		{
+			PlayerController->InputKey(Key, IE_Released, 0.f, false);
+		}
+	}
+	HeldKeys.Reset();
+}
+
+void USoakTestSubsystem::TakeSample()
+{
+	const uint64 UsedPhysical{ FPlatformMemory::GetStats().UsedPhysical };
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, UsedPhysical);
+	NumSamples++;
+
+	if (!bHasBaseline)
+	{
+		bHasBaseline = true;
+		BaselineUsedPhysical = UsedPhysical;
+		CountObjectsByClass(BaselineObjectCounts);
+	}
+
+	UE_LOG(LogShooter, Log, TEXT("Soak sample %d: %.1f MB used, %d objects, %.0f seconds left"),
+		NumSamples, UsedPhysical / (1024.0 * 1024.0), GUObjectArray.GetObjectArrayNumMinusAvailable(), RemainingTime);
+}
+
+void USoakTestSubsystem::CountObjectsByClass(TMap<FName, int32>& OutCounts) const
+{
+	OutCounts.Reset();
+	for (TObjectIterator<UObject> It; It; ++It)
+	{
+		OutCounts.FindOrAdd(It->GetClass()->GetFName())++;
+	}
+}
+
+void USoakTestSubsystem::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void USoakTestSubsystem::OnPostGarbageCollect()
+{
+	GCPauses.Add(static_cast<float>((FPlatformTime::Seconds() - GCStartTime) * 1000.0));
+}
+
+void USoakTestSubsystem::OnFinalGarbageCollect()
+{
+	bFinalGCDone = true;
+}
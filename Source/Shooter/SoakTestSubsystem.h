@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SoakTestSubsystem.generated.h"
+
+/**
+ * Long-running leak check. While running, every local player is driven by scripted input (move, fire, aim,
+ * reload, crouch, sprint, pick up and swap), and memory, live UObjects per class and GC pauses are sampled.
+ * When the run ends the growth is compared against fixed budgets and the result is logged as PASSED or FAILED.
+ * The Shooter.Soak.LeakAndGC automation test drives a run on the default map and fails with it
+ */
+UCLASS()
+class SHOOTER_API USoakTestSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	// starts a run lasting Duration seconds of game time
+	void StartSoak(float Duration);
+
+	// ends the current run early; the result is reported after a full garbage collection on a later frame
+	void StopSoak();
+
+	bool IsSoaking() const { return bSoaking || bAwaitingFinalGC; }
+
+	// true once a run has been judged; bLastRunPassed is only meaningful then
+	bool HasResult() const { return bHasResult; }
+	bool DidLastRunPass() const { return bLastRunPassed; }
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return bSoaking || bAwaitingFinalGC; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	void DriveBots(float DeltaTime);
+	void ReleaseBotKeys();
+	void TakeSample();
+
+	// compares the final sample against the baseline and budgets
+	void FinishSoak();
+	void ReportResult(bool bPassed);
+	void CountObjectsByClass(TMap<FName, int32>& OutCounts) const;
+
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+	void OnFinalGarbageCollect();
+
+	bool bSoaking = false;
+
+	// set between StopSoak and the collection it requested
+	bool bAwaitingFinalGC = false;
+	bool bFinalGCDone = false;
+
+	bool bHasResult = false;
+	bool bLastRunPassed = false;
+
+	// game time left in the run and until the next sample
+	float RemainingTime = 0.f;
+	float SampleCountdown = 0.f;
+
+	// time until the scripted players pick their next action
+	float BotActionCountdown = 0.f;
+
+	// keys currently held down by the scripted players
+	TArray<FKey> HeldKeys;
+
+	// taken once the warm-up is over, so streaming and pool warming aren't counted as leaks
+	bool bHasBaseline = false;
+	uint64 BaselineUsedPhysical = 0;
+	TMap<FName, int32> BaselineObjectCounts;
+
+	uint64 PeakUsedPhysical = 0;
+	int32 NumSamples = 0;
+
+	// every GC pause seen during the run, in milliseconds
+	TArray<float> GCPauses;
+	double GCStartTime = 0.0;
+
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+};
@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Shooter.h"
+#include "ShooterCharacter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr float BenchmarkDeltaTime = 1.f / 30.f;
+
+	// ticks every character directly for NumFrames, the same scope as STAT_ShooterCharacterTick, and returns ns per character tick
+	double TimeCharacterTicks(TArrayView<AShooterCharacter* const> Characters, int32 NumFrames)
+	{
+		uint64 TimedCycles{ 0 };
+		for (int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			const uint64 FrameStart{ FPlatformTime::Cycles64() };
+			for (AShooterCharacter* Character : Characters)
+			{
+				Character->Tick(BenchmarkDeltaTime);
+			}
+			TimedCycles += FPlatformTime::Cycles64() - FrameStart;
+		}
+		return FPlatformTime::ToSeconds64(TimedCycles) * 1e9 / FMath::Max(1, Characters.Num() * NumFrames);
+	}
+
+	// a game world holding NumCharacters shooters, each overlapping an item so it traces every tick like one standing in a pickup
+	struct FCharacterTickBenchmarkWorld
+	{
+		explicit FCharacterTickBenchmarkWorld(int32 NumCharacters)
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			for (int32 i = 0; i < NumCharacters; i++)
+			{
+				// a grid, so the characters don't stand inside each other
+				const FVector Location{ static_cast<float>(i % 20) * 200.f, static_cast<float>(i / 20) * 200.f, 0.f };
+				if (AShooterCharacter* Character = World->SpawnActor<AShooterCharacter>(Location, FRotator::ZeroRotator, SpawnParams))
+				{
+					Character->IncrementOverlappedItemCount(1);
+					Characters.Add(Character);
+				}
+			}
+		}
+
+		~FCharacterTickBenchmarkWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		UWorld* World;
+		TArray<AShooterCharacter*> Characters;
+	};
+}
+
+// on a dedicated server: ShooterServer -nullrhi -ExecCmds="Automation RunTests Shooter.Perf.ServerCosmetics, Quit"
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FServerCosmeticsBenchmarkTest, "Shooter.Perf.ServerCosmetics",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FServerCosmeticsBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCharacters = 64;
+	constexpr int32 NumFrames = 300;
+
+	FCharacterTickBenchmarkWorld BenchmarkWorld(NumCharacters);
+	if (!TestEqual(TEXT("characters spawned"), BenchmarkWorld.Characters.Num(), NumCharacters))
+	{
+		return false;
+	}
+
+	if (BenchmarkWorld.World->GetNetMode() != NM_DedicatedServer)
+	{
+		AddWarning(TEXT("Not a dedicated server, so cosmetics run either way; run this under -server to measure the stripping"));
+	}
+
+	// server builds compile the cosmetic branches out, and the cvar with them
+	IConsoleVariable* RunCosmetics = IConsoleManager::Get().FindConsoleVariable(TEXT("shooter.Server.RunCosmetics"));
+	if (RunCosmetics == nullptr)
+	{
+		TimeCharacterTicks(BenchmarkWorld.Characters, NumFrames);
+		const double StrippedNanoseconds{ TimeCharacterTicks(BenchmarkWorld.Characters, NumFrames) };
+		AddInfo(FString::Printf(TEXT("Server build, cosmetics compiled out: %.1f ns per character tick"), StrippedNanoseconds));
+		return true;
+	}
+
+	const int32 PreviousValue{ RunCosmetics->GetInt() };
+
+	// the first pass of each setting only warms the caches and settles the interpolations
+	RunCosmetics->Set(0, ECVF_SetByCode);
+	TimeCharacterTicks(BenchmarkWorld.Characters, NumFrames);
+	const double StrippedNanoseconds{ TimeCharacterTicks(BenchmarkWorld.Characters, NumFrames) };
+
+	RunCosmetics->Set(1, ECVF_SetByCode);
+	TimeCharacterTicks(BenchmarkWorld.Characters, NumFrames);
+	const double CosmeticNanoseconds{ TimeCharacterTicks(BenchmarkWorld.Characters, NumFrames) };
+
+	RunCosmetics->Set(PreviousValue, ECVF_SetByCode);
+
+	const FString Report{ FString::Printf(TEXT("%d characters, %d frames: %.1f ns per character tick stripped, %.1f ns with cosmetics, %.1f ns saved"),
+		NumCharacters, NumFrames, StrippedNanoseconds, CosmeticNanoseconds, CosmeticNanoseconds - StrippedNanoseconds) };
+	UE_LOG(LogShooter, Display, TEXT("Server cosmetics benchmark: %s"), *Report);
+	AddInfo(Report);
+	return true;
+}
+
+// Scripts/perf_character_tick.sh runs this under perf stat for the cache misses; -ShooterTickFrames=N overrides the frame count,
+// and 0 only spawns, which gives the script a baseline to subtract
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCharacterTickBenchmarkTest, "Shooter.Perf.CharacterTick",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCharacterTickBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCharacters = 200;
+
+	int32 NumFrames{ 600 };
+	FParse::Value(FCommandLine::Get(), TEXT("ShooterTickFrames="), NumFrames);
+	NumFrames = FMath::Max(NumFrames, 0);
+
+	FCharacterTickBenchmarkWorld BenchmarkWorld(NumCharacters);
+	if (!TestEqual(TEXT("characters spawned"), BenchmarkWorld.Characters.Num(), NumCharacters))
+	{
+		return false;
+	}
+	if (NumFrames == 0)
+	{
+		return true;
+	}
+
+	const double Nanoseconds{ TimeCharacterTicks(BenchmarkWorld.Characters, NumFrames) };
+	const FString Report{ FString::Printf(TEXT("%d characters, %d frames: %.1f ns per character tick, %.3f ms per frame"),
+		NumCharacters, NumFrames, Nanoseconds, Nanoseconds * NumCharacters / 1e6) };
+	UE_LOG(LogShooter, Display, TEXT("Character tick benchmark: %s"), *Report);
+	AddInfo(Report);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ShooterCharacter.h"
+#include "Weapon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponAmmoTest, "Shooter.Combat.Actors.WeaponAmmo",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponAmmoTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AWeapon* Weapon = World->SpawnActor<AWeapon>(FVector::ZeroVector, FRotator::ZeroRotator);
+	if (TestNotNull(TEXT("weapon"), Weapon))
+	{
+		const int32 Capacity{ Weapon->GetMagazineCapacity() };
+		Weapon->SetAmmo(Capacity);
+		TestTrue(TEXT("A magazine at capacity is full"), Weapon->ClipIsFull());
+
+		Weapon->DecrementAmmo();
+		TestEqual(TEXT("A shot takes one round"), Weapon->GetAmmo(), Capacity - 1);
+		TestFalse(TEXT("A magazine below capacity is not full"), Weapon->ClipIsFull());
+
+		Weapon->ReloadAmmo(1);
+		TestTrue(TEXT("Reloading the missing round fills the magazine"), Weapon->ClipIsFull());
+
+		Weapon->SetAmmo(0);
+		Weapon->DecrementAmmo();
+		TestEqual(TEXT("An empty magazine stays empty"), Weapon->GetAmmo(), 0);
+
+		// overfilling is reported, then clamped instead of carrying rounds past the capacity
+		AddExpectedError(TEXT("Attempted to reload with more than magazine capacity"), EAutomationExpectedErrorFlags::Contains, 1);
+		Weapon->SetAmmo(Capacity - 1);
+		Weapon->ReloadAmmo(5);
+		TestEqual(TEXT("An overfilling reload stops at the capacity"), Weapon->GetAmmo(), Capacity);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCharacterReloadTest, "Shooter.Combat.Actors.CharacterReload",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCharacterReloadTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AShooterCharacter* Character = World->SpawnActor<AShooterCharacter>(FVector::ZeroVector, FRotator::ZeroRotator);
+	AWeapon* Weapon = World->SpawnActor<AWeapon>(FVector::ZeroVector, FRotator::ZeroRotator);
+	UFunction* FinishReloading = Character ? Character->FindFunction(TEXT("FinishReloading")) : nullptr;
+	if (TestNotNull(TEXT("character"), Character) && TestNotNull(TEXT("weapon"), Weapon) && TestNotNull(TEXT("FinishReloading"), FinishReloading))
+	{
+		// the test world never begins play, so fill the ammo map by hand; the native class has no default weapon to spawn
+		Character->DispatchBeginPlay();
+		TestFalse(TEXT("Carrying no ammo without a weapon"), Character->CarryingAmmo());
+
+		Character->GetPickupItem(Weapon);
+		TestEqual(TEXT("The picked up weapon is equipped"), Character->GetEquippedWeapon(), Weapon);
+
+		const int32 Capacity{ Weapon->GetMagazineCapacity() };
+		const int32 StartingCarried{ Character->GetCarriedAmmo() };
+		TestTrue(TEXT("Carrying ammo for the equipped weapon"), Character->CarryingAmmo());
+
+		Weapon->SetAmmo(Capacity - 10);
+		Character->ProcessEvent(FinishReloading, nullptr);
+		TestTrue(TEXT("A reload from a large reserve fills the magazine"), Weapon->ClipIsFull());
+		TestEqual(TEXT("The reload takes what the magazine was missing"), Character->GetCarriedAmmo(), StartingCarried - 10);
+		TestEqual(TEXT("Reloading finishes unoccupied"), Character->GetCombatState(), ECombatState::ECS_Unoccupied);
+
+		// empty the reserve, then reload from a reserve smaller than the magazine
+		while (Character->CarryingAmmo() && Character->GetCarriedAmmo() >= Capacity)
+		{
+			Weapon->SetAmmo(0);
+			Character->ProcessEvent(FinishReloading, nullptr);
+		}
+		const int32 LastCarried{ Character->GetCarriedAmmo() };
+		Weapon->SetAmmo(0);
+		Character->ProcessEvent(FinishReloading, nullptr);
+		TestEqual(TEXT("A small reserve goes into the magazine"), Weapon->GetAmmo(), LastCarried);
+		TestFalse(TEXT("Carrying no ammo once the reserve is used up"), Character->CarryingAmmo());
+
+		Character->ProcessEvent(FinishReloading, nullptr);
+		TestEqual(TEXT("Reloading with no reserve leaves the magazine alone"), Weapon->GetAmmo(), LastCarried);
+
+		Character->IncrementOverlappedItemCount(1);
+		Character->IncrementOverlappedItemCount(1);
+		Character->IncrementOverlappedItemCount(-1);
+		TestEqual(TEXT("Overlapped items add up"), Character->GetOverlappedItemCount(), static_cast<int8>(1));
+		Character->IncrementOverlappedItemCount(-5);
+		TestEqual(TEXT("Overlapped items never drop below zero"), Character->GetOverlappedItemCount(), static_cast<int8>(0));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Shooter.h"
+#include "CombatRules.h"
+#include "ShooterTuningSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int32 BenchmarkIterations = 1'000'000;
+
+	// far above what each rule costs on a build machine, so only a real regression (an allocation, a lock, a lost inline) trips them
+	constexpr double InlineRuleBudgetNs = 10.0;
+	constexpr double MapLookupBudgetNs = 50.0;
+	constexpr double CrosshairUpdateBudgetNs = 100.0;
+
+	// times Function over BenchmarkIterations, logs ns/op and fails Test when it is over BudgetNs
+	template<typename FunctionType>
+	void TimeRule(FAutomationTestBase& Test, const TCHAR* Name, double BudgetNs, FunctionType&& Function)
+	{
+		// accumulate results so the loop can't be optimized away
+		int64 Sink{ 0 };
+		const uint64 StartCycles{ FPlatformTime::Cycles64() };
+		for (int32 i = 0; i < BenchmarkIterations; i++)
+		{
+			Sink += Function(i);
+		}
+		const double NanosecondsPerOp{ FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1e9 / BenchmarkIterations };
+		UE_LOG(LogShooter, Display, TEXT("Combat benchmark: %s %.2f ns/op (%lld)"), Name, NanosecondsPerOp, Sink);
+
+		// unoptimized builds only report
+#if !UE_BUILD_DEBUG
+		Test.TestTrue(FString::Printf(TEXT("%s takes %.2f ns/op, budget %.0f ns/op"), Name, NanosecondsPerOp, BudgetNs), NanosecondsPerOp <= BudgetNs);
+#endif
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatMagazineBenchmarkTest, "Shooter.Combat.Benchmark.Magazine",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatMagazineBenchmarkTest::RunTest(const FString& Parameters)
+{
+	TimeRule(*this, TEXT("GetReloadAmount"), InlineRuleBudgetNs, [](int32 i) { return FCombatRules::GetReloadAmount(i & 31, 30, i & 127); });
+	TimeRule(*this, TEXT("GetAmmoAfterShot"), InlineRuleBudgetNs, [](int32 i) { return FCombatRules::GetAmmoAfterShot(i & 31); });
+	TimeRule(*this, TEXT("IsMagazineFull"), InlineRuleBudgetNs, [](int32 i) { return FCombatRules::IsMagazineFull(i & 31, 30) ? 1 : 0; });
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatPickupBenchmarkTest, "Shooter.Combat.Benchmark.Pickups",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatPickupBenchmarkTest::RunTest(const FString& Parameters)
+{
+	TimeRule(*this, TEXT("GetOverlapCountAfter"), InlineRuleBudgetNs, [](int32 i) { return FCombatRules::GetOverlapCountAfter(static_cast<int8>(i & 7), (i & 1) ? 1 : -1); });
+
+	TMap<EAmmoType, int32> AmmoMap;
+	AmmoMap.Add(EAmmoType::EAT_9mm, 120);
+	AmmoMap.Add(EAmmoType::EAT_AR, 90);
+	AmmoMap.Add(EAmmoType::EAT_Shells, 24);
+	TimeRule(*this, TEXT("GetCarriedAmmo"), MapLookupBudgetNs, [&AmmoMap](int32 i)
+	{
+		return FCombatRules::GetCarriedAmmo(AmmoMap, static_cast<EAmmoType>(i % static_cast<int32>(EAmmoType::EAT_MAX)));
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCrosshairSpreadBenchmarkTest, "Shooter.Combat.Benchmark.CrosshairSpread",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCrosshairSpreadBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const FShooterTuning Tuning;
+	FCrosshairSpread Spread;
+	TimeRule(*this, TEXT("FCrosshairSpread::Update"), CrosshairUpdateBudgetNs, [&Spread, &Tuning](int32 i)
+	{
+		Spread.Update(Tuning, 1.f / 60.f, static_cast<float>(i & 1023), (i & 64) != 0, (i & 128) != 0, (i & 8) != 0);
+		return static_cast<int64>(Spread.GetMultiplier() * 1000.f);
+	});
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "CombatRules.h"
+#include "ShooterTuningSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatRulesReloadTest, "Shooter.Combat.ReloadAmount",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatRulesReloadTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("Empty magazine fills from a large reserve"), FCombatRules::GetReloadAmount(0, 30, 100), 30);
+	TestEqual(TEXT("Small reserve is used up"), FCombatRules::GetReloadAmount(10, 30, 5), 5);
+	TestEqual(TEXT("Full magazine takes nothing"), FCombatRules::GetReloadAmount(30, 30, 100), 0);
+	TestEqual(TEXT("Overfilled magazine takes nothing"), FCombatRules::GetReloadAmount(35, 30, 100), 0);
+	TestEqual(TEXT("Negative reserve takes nothing"), FCombatRules::GetReloadAmount(10, 30, -3), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatRulesMagazineTest, "Shooter.Combat.Magazine",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatRulesMagazineTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("A shot takes one round"), FCombatRules::GetAmmoAfterShot(1), 0);
+	TestEqual(TEXT("An empty magazine stays empty"), FCombatRules::GetAmmoAfterShot(0), 0);
+	TestTrue(TEXT("Magazine is full at capacity"), FCombatRules::IsMagazineFull(30, 30));
+	TestFalse(TEXT("Magazine is not full below capacity"), FCombatRules::IsMagazineFull(29, 30));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatRulesCarriedAmmoTest, "Shooter.Combat.CarriedAmmo",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatRulesCarriedAmmoTest::RunTest(const FString& Parameters)
+{
+	TMap<EAmmoType, int32> AmmoMap;
+	AmmoMap.Add(EAmmoType::EAT_9mm, 12);
+
+	TestEqual(TEXT("Carried ammo of an added type"), FCombatRules::GetCarriedAmmo(AmmoMap, EAmmoType::EAT_9mm), 12);
+	TestEqual(TEXT("Carried ammo of a type never added"), FCombatRules::GetCarriedAmmo(AmmoMap, EAmmoType::EAT_AR), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatRulesOverlapCountTest, "Shooter.Combat.OverlapCount",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatRulesOverlapCountTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("Overlap count adds"), FCombatRules::GetOverlapCountAfter(1, 1), static_cast<int8>(2));
+	TestEqual(TEXT("Overlap count clamps at zero"), FCombatRules::GetOverlapCountAfter(1, -2), static_cast<int8>(0));
+	TestEqual(TEXT("Overlap count clamps instead of wrapping"), FCombatRules::GetOverlapCountAfter(MAX_int8, 1), static_cast<int8>(MAX_int8));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCrosshairSpreadTest, "Shooter.Combat.CrosshairSpread",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCrosshairSpreadTest::RunTest(const FString& Parameters)
+{
+	// the shipped defaults, so live tuning doesn't move the known answers
+	const FShooterTuning Tuning;
+	FCrosshairSpread Spread;
+	TestEqual(TEXT("Spread at rest"), Spread.GetMultiplier(), 0.5f);
+
+	for (int32 Frame = 0; Frame < 600; Frame++)
+	{
+		Spread.Update(Tuning, 1.f / 60.f, Tuning.SpreadWalkSpeed * 2.f, false, true, false);
+	}
+	TestEqual(TEXT("Running while aiming settles at full velocity spread less the aim spread"), Spread.GetMultiplier(), 0.5f + 1.f - Tuning.AimSpread, 0.01f);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
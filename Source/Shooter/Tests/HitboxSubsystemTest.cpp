@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "HitboxSubsystem.h"
+#include "ShooterHitboxComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitboxStalePoseTest, "Shooter.Hitboxes.StalePoseDoesNotBlock",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FHitboxStalePoseTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	UHitboxSubsystem* HitboxSubsystem = World->GetSubsystem<UHitboxSubsystem>();
+	ACharacter* Character = World->SpawnActor<ACharacter>(FVector::ZeroVector, FRotator::ZeroRotator);
+	if (TestNotNull(TEXT("hitbox subsystem"), HitboxSubsystem) && TestNotNull(TEXT("character"), Character))
+	{
+		// the test world never begins play, so register by hand; with no skeletal mesh every capsule sits on the mesh origin
+		UShooterHitboxComponent* HitboxComponent = NewObject<UShooterHitboxComponent>(Character);
+		HitboxComponent->RegisterComponent();
+		HitboxSubsystem->RegisterHitboxes(HitboxComponent);
+
+		const FVector OldStart{ -500.f, 0.f, 0.f };
+		const FVector OldEnd{ 500.f, 0.f, 0.f };
+
+		FHitResult HitResult;
+		TestTrue(TEXT("a shot through the character hits its hitboxes"), HitboxSubsystem->TraceHitboxes(HitResult, OldStart, OldEnd, nullptr));
+
+		// moved out of the activation radius of the next shot, in the same frame as the first one
+		Character->SetActorLocation(FVector(0.f, 2'000.f, 0.f), false, nullptr, ETeleportType::TeleportPhysics);
+
+		TestFalse(TEXT("a shot through the old position misses once the character has moved"), HitboxSubsystem->TraceHitboxes(HitResult, OldStart, OldEnd, nullptr));
+
+		HitboxSubsystem->UnregisterHitboxes(HitboxComponent);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+#include "GameMapsSettings.h"
+#include "Engine/World.h"
+#include "SoakTestSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// an hour of game time; -ShooterSoakSeconds=N overrides it
+	constexpr float DefaultSoakDuration = 3'600.f;
+}
+
+// starts a soak in the loaded game world, then waits for it to be judged
+class FRunShooterSoakCommand : public IAutomationLatentCommand
+{
+public:
+	FRunShooterSoakCommand(FAutomationTestBase* InTest, float InDuration) :
+		Test(InTest),
+		Duration(InDuration)
+	{
+
+	}
+
+	virtual bool Update() override
+	{
+		UWorld* World = AutomationCommon::GetAnyGameWorld();
+		USoakTestSubsystem* Soak = World ? World->GetSubsystem<USoakTestSubsystem>() : nullptr;
+		if (Soak == nullptr)
+		{
+			Test->AddError(TEXT("No game world with a soak test subsystem"));
+			return true;
+		}
+
+		if (!bStarted)
+		{
+			bStarted = true;
+			Soak->StartSoak(Duration);
+			return false;
+		}
+
+		if (Soak->IsSoaking()) return false;
+
+		Test->TestTrue(TEXT("Soak stays within its memory, object and GC pause budgets"), Soak->HasResult() && Soak->DidLastRunPass());
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	float Duration;
+	bool bStarted = false;
+};
+
+// headless: -nullrhi -UseFixedTimeStep -FPS=30 -ExecCmds="Automation RunTests Shooter.Soak" covers the hour as fast as the machine allows
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FShooterSoakTest, "Shooter.Soak.LeakAndGC",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::StressFilter)
+
+bool FShooterSoakTest::RunTest(const FString& Parameters)
+{
+	float Duration{ DefaultSoakDuration };
+	FParse::Value(FCommandLine::Get(), TEXT("ShooterSoakSeconds="), Duration);
+
+	AutomationOpenMap(UGameMapsSettings::GetGameDefaultMap());
+	ADD_LATENT_AUTOMATION_COMMAND(FRunShooterSoakCommand(this, Duration > 0.f ? Duration : DefaultSoakDuration));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
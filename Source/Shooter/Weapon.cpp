@@ -2,6 +2,8 @@
 
 
 #include "Weapon.h"
+#include "CombatRules.h"
+#include "Shooter.h"
 
 AWeapon::AWeapon() :
 	ThrowWeaponTime(0.7f),
@@ -10,8 +12,13 @@ AWeapon::AWeapon() :
 	MagazineCapacity(30),
 	WeaponType(EWeaponType::EWT_SubmachineGun),
 	AmmoType(EAmmoType::EAT_9mm),
+	PelletCount(1),
+	FireMode(EFireMode::EFM_FullAuto),
+	FireInterval(0.1f),
+	BurstCount(3),
 	ReloadMontageSection(FName(TEXT("Reload SMG"))),
-	ClipBoneName(TEXT("smg_clip"))
+	ClipBoneName(TEXT("smg_clip")),
+	ClipBoneIndex(INDEX_NONE)
 
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -44,9 +51,18 @@ void AWeapon::ThrowWeapon()
 	ImpusleDirection *= 10'000.f;
 	GetItemMesh()->AddImpulse(ImpusleDirection);
 
+	StartFalling();
+}
+
+void AWeapon::StartFalling()
+{
+	if (GetItemState() != EItemState::EIS_Falling)
+	{
+		SetItemState(EItemState::EIS_Falling);
+	}
+
 	bFalling = true;
 	GetWorldTimerManager().SetTimer(ThrowWeaponTimer, this, &AWeapon::StopFalling, ThrowWeaponTime);
-
 }
 
 void AWeapon::StopFalling()
@@ -55,25 +71,43 @@ void AWeapon::StopFalling()
 	SetItemState(EItemState::EIS_Pickup);
 }
 
+void AWeapon::ResetForPool()
+{
+	GetWorldTimerManager().ClearTimer(ThrowWeaponTimer);
+	bFalling = false;
+	bMovingClip = false;
+	Ammo = GetClass()->GetDefaultObject<AWeapon>()->Ammo;
+
+	Super::ResetForPool();
+}
+
 void AWeapon::DecrementAmmo()
 {
-	if (Ammo - 1 <= 0)
-	{
-		Ammo = 0;
-	}
-	else
-	{
-		--Ammo;
-	}
+	Ammo = FCombatRules::GetAmmoAfterShot(Ammo);
 }
 
 void AWeapon::ReloadAmmo(int32 Amount)
 {
-	checkf(Ammo + Amount <= MagazineCapacity, TEXT("Attempted to reload with more than magazine capacity"));
+	if (Ammo + Amount > MagazineCapacity)
+	{
+		UE_LOG(LogShooter, Error, TEXT("Attempted to reload with more than magazine capacity: %d + %d > %d on %s"), Ammo, Amount, MagazineCapacity, *GetName());
+		Ammo = MagazineCapacity;
+		return;
+	}
 	Ammo += Amount;
 }
 
+void AWeapon::SetAmmo(int32 Amount)
+{
+	Ammo = FMath::Clamp(Amount, 0, MagazineCapacity);
+}
+
+void AWeapon::CacheBoneIndices()
+{
+	ClipBoneIndex = GetItemMesh()->GetBoneIndex(ClipBoneName);
+}
+
 bool AWeapon::ClipIsFull()
 {
-	return Ammo >= MagazineCapacity ;
+	return FCombatRules::IsMagazineFull(Ammo, MagazineCapacity);
 }
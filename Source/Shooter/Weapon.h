@@ -5,17 +5,10 @@
 #include "CoreMinimal.h"
 #include "Item.h"
 #include "AmmoType.h"
+#include "WeaponType.h"
+#include "FireMode.h"
 #include "Weapon.generated.h"
 
-UENUM(BlueprintType)
-enum class EWeaponType : uint8
-{
-	EWT_SubmachineGun UMETA(DisplayName = "SubmachineGun"),
-	EWT_AssaultRifle UMETA(DisplayName = "AssaultRifle"),
-
-	EWT_MAX UMETA(DisplayName = "DefaultMAX")
-};
-
 /**
  * 
  */
@@ -50,6 +43,22 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
 	EAmmoType AmmoType;
 
+	// traces fired per shot; 1 for bullets, 8-12 for shotguns
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true", ClampMin = "1", ClampMax = "16"))
+	int32 PelletCount;
+
+	// how the trigger fires this weapon
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
+	EFireMode FireMode;
+
+	// seconds between shots
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true", ClampMin = "0.01"))
+	float FireInterval;
+
+	// shots per trigger pull in burst mode
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true", ClampMin = "1", EditCondition = "FireMode == EFireMode::EFM_Burst"))
+	int32 BurstCount;
+
 	// FName for the reload montage section
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
 	FName ReloadMontageSection;
@@ -62,11 +71,23 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
 	FName ClipBoneName;
 
+	// bone index of ClipBoneName on the item mesh, cached when the weapon is equipped
+	int32 ClipBoneIndex;
+
+	// scene component on the characters hand that the clip follows while reloading
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
+	class USceneComponent* ClipHandComponent;
 
 public:
 	//adds and impulse to the weapon
 	void ThrowWeapon();
 
+	// drops under physics from where the weapon is and becomes a pickup again after ThrowWeaponTime
+	void StartFalling();
+
+	// refills the magazine and stops any throw in progress
+	virtual void ResetForPool() override;
+
 	FORCEINLINE int32 GetAmmo() const { return Ammo; }
 	FORCEINLINE int32 GetMagazineCapacity() const { return MagazineCapacity; }
 
@@ -75,12 +96,28 @@ public:
 
 	FORCEINLINE EWeaponType GetWeaponType() const { return WeaponType; }
 	FORCEINLINE EAmmoType GetAmmoType() const { return AmmoType; }
+	FORCEINLINE int32 GetPelletCount() const { return PelletCount; }
+	FORCEINLINE EFireMode GetFireMode() const { return FireMode; }
+	FORCEINLINE float GetFireInterval() const { return FireInterval; }
+	FORCEINLINE int32 GetBurstCount() const { return BurstCount; }
 	FORCEINLINE FName GetReloadMontageSection() const { return ReloadMontageSection; }
 	FORCEINLINE FName GetClipBoneName() const { return ClipBoneName; }
 
+	// adds Amount to the magazine; more than it has room for is a caller bug, reported and clamped to the capacity
 	void ReloadAmmo(int32 Amount);
 
+	// sets the magazine directly, clamped to its capacity; used when restoring a checkpoint
+	void SetAmmo(int32 Amount);
+
 	FORCEINLINE void SetMovingClip(bool Move) { bMovingClip = Move; }
+	FORCEINLINE bool GetMovingClip() const { return bMovingClip; }
+
+	// resolves bone indices on the item mesh; called once when equipped
+	void CacheBoneIndices();
+	FORCEINLINE int32 GetClipBoneIndex() const { return ClipBoneIndex; }
+
+	FORCEINLINE USceneComponent* GetClipHandComponent() const { return ClipHandComponent; }
+	FORCEINLINE void SetClipHandComponent(USceneComponent* HandComponent) { ClipHandComponent = HandComponent; }
 
 	bool ClipIsFull();
 };
@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponAnimInstance.h"
+#include "Weapon.h"
+#include "Components/SceneComponent.h"
+
+UWeaponAnimInstance::UWeaponAnimInstance() :
+	bMovingClip(false),
+	HandTransform(FTransform::Identity)
+{
+
+}
+
+void UWeaponAnimInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+
+	Weapon = Cast<AWeapon>(GetOwningActor());
+}
+
+void UWeaponAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
+	if (Weapon == nullptr) return;
+
+	bMovingClip = Weapon->GetMovingClip();
+
+	// a single transform copy; the bone itself is moved on the worker thread
+	if (bMovingClip && Weapon->GetClipHandComponent())
+	{
+		HandTransform = Weapon->GetClipHandComponent()->GetComponentTransform();
+	}
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "WeaponAnimInstance.generated.h"
+
+/**
+ * Anim instance for weapon meshes. Copies the clip state from the owning weapon
+ * so the Move Clip node can read it on the anim worker thread.
+ */
+UCLASS()
+class SHOOTER_API UWeaponAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+public:
+
+	UWeaponAnimInstance();
+
+	virtual void NativeInitializeAnimation() override;
+
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+private:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	class AWeapon* Weapon;
+
+	// true while the character is moving the clip during a reload
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	bool bMovingClip;
+
+	// world transform of the hand scene component; only updated while moving the clip
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	FTransform HandTransform;
+};
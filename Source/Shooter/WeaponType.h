@@ -0,0 +1,11 @@
+#pragma once
+
+UENUM(BlueprintType)
+enum class EWeaponType : uint8
+{
+	EWT_SubmachineGun UMETA(DisplayName = "SubmachineGun"),
+	EWT_AssaultRifle UMETA(DisplayName = "AssaultRifle"),
+	EWT_Shotgun UMETA(DisplayName = "Shotgun"),
+
+	EWT_MAX UMETA(DisplayName = "DefaultMAX")
+};
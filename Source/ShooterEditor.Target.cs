@@ -9,6 +9,6 @@ public class ShooterEditorTarget : TargetRules
 	{
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V2;
-		ExtraModuleNames.AddRange( new string[] { "Shooter" } );
+		ExtraModuleNames.AddRange( new string[] { "Shooter", "ShooterEditor" } );
 	}
 }
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AnimGraphNode_MoveClip.h"
+
+#define LOCTEXT_NAMESPACE "AnimGraphNode_MoveClip"
+
+FText UAnimGraphNode_MoveClip::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return GetControllerDescription();
+}
+
+FText UAnimGraphNode_MoveClip::GetTooltipText() const
+{
+	return LOCTEXT("MoveClipTooltip", "Moves the weapon clip bone to the hand transform while reloading.");
+}
+
+FText UAnimGraphNode_MoveClip::GetControllerDescription() const
+{
+	return LOCTEXT("MoveClip", "Move Clip");
+}
+
+#undef LOCTEXT_NAMESPACE